@@ -135,6 +135,7 @@ public:
                 {
                     ImGui::Checkbox("Console", &this->consoleGui);
                     ImGui::Checkbox("Run Python Code", &this->pythonGui);
+                    ImGui::Checkbox("Input Latency", &this->latencyGui);
                     ImGui::Checkbox("imgui Demo", &this->demoGui);
 
                     ImGui::EndMenu();
@@ -146,6 +147,7 @@ public:
         this->demoWindow();
         this->console();
         this->python();
+        this->latency();
     }
 
     void setScope(const py::object& scope)
@@ -291,6 +293,7 @@ private:
 
     bool consoleGui = false;
     bool pythonGui = false;
+    bool latencyGui = false;
     bool pythonHasFocus = false;
     bool wantsRunPython = false;
     TextEditor editor;
@@ -498,6 +501,56 @@ private:
         ImGui::End();
     }
 
+    static void LatencyRow(const char* name, const LatencyStats& stats, const char* unit, float scale)
+    {
+        ImGui::TableNextRow();
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(name);
+        ImGui::TableNextColumn();
+        ImGui::Text("%zu", stats.count);
+
+        for (double value : { stats.p50, stats.p95, stats.p99, stats.max })
+        {
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f%s", value * scale, unit);
+        }
+    }
+
+    void latency()
+    {
+        if (!this->latencyGui)
+            return;
+
+        ImGui::Begin("Input Latency", &this->latencyGui);
+        {
+            if (ImGui::Button("Reset")) Input::resetLatencyStats();
+
+            constexpr int TABLE_FLAGS =
+                ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+
+            for (auto&& [name, stats] : Input::latencyStats())
+            {
+                if (!ImGui::CollapsingHeader(name.c_str())) continue;
+
+                if (ImGui::BeginTable(name.c_str(), 6, TABLE_FLAGS))
+                {
+                    for (auto&& column : { "", "count", "p50", "p95", "p99", "max" })
+                    {
+                        ImGui::TableSetupColumn(column);
+                    }
+
+                    ImGui::TableHeadersRow();
+                    LatencyRow("started", stats.started, "ms", 1000.f);
+                    LatencyRow("finished", stats.finished, "ms", 1000.f);
+                    LatencyRow("confirmed", stats.confirmed, "ms", 1000.f);
+                    LatencyRow("confirmed frames", stats.confirmedFrames, " frames", 1.f);
+                    ImGui::EndTable();
+                }
+            }
+        }
+        ImGui::End();
+    }
+
     void python()
     {
         if (!this->pythonGui)
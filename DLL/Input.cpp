@@ -2,18 +2,21 @@
 #include "Utility/Memory.hpp"
 #include "Utility/Exceptions.hpp"
 #include "Utility/Float.hpp"
+#include "Utility/RingBuffer.hpp"
 #include "Python/Bind.hpp"
 
 #include <array>
 #include <vector>
-#include <list>
 #include <algorithm>
 #include <tuple>
 #include <variant>
+#include <unordered_map>
+#include <map>
 
 struct WaitCommand
 {
 	double time = 0.0;
+	double until = -1.0; // set once it starts waiting
 };
 
 struct MouseCommand
@@ -31,6 +34,11 @@ struct KeyboardCommand
 	InputDirection direction = InputDirection::Unchanged;
 };
 
+struct TextCommand
+{
+	std::string text;
+};
+
 struct CheatCommand
 {
 	std::string command;
@@ -165,13 +173,19 @@ struct Command
 
 	Type type = Type::None;
 	uintmax_t id = 0;
+	uintmax_t parent = 0; // the command that queued this one while running, if any
+	CommandPriority priority = CommandPriority::Normal;
+	std::string tag;
+
+	// For latency stats, see Input::latencyStats()
+	double queuedAt = 0.0, startedAt = -1.0;
 
 	std::variant<
 		std::monostate,
 		WaitCommand,
 		MouseCommand,
 		KeyboardCommand,
-		char,
+		TextCommand,
 		raw::TextEvent,
 		CheatCommand,
 		bool,
@@ -192,11 +206,87 @@ struct Command
 	> args;
 };
 
+namespace
+{
+
+const char* commandTypeName(Command::Type type)
+{
+	switch (type)
+	{
+	case Command::Type::Wait: return "wait";
+	case Command::Type::Mouse: return "mouse";
+	case Command::Type::Keyboard: return "keyboard";
+	case Command::Type::TextInput: return "text_input";
+	case Command::Type::TextEvent: return "text_event";
+	case Command::Type::Cheat: return "cheat";
+	case Command::Type::Pause: return "pause";
+	case Command::Type::EventChoice: return "event_choice";
+	case Command::Type::PowerSystem: return "power_system";
+	case Command::Type::PowerWeapon: return "power_weapon";
+	case Command::Type::PowerDrone: return "power_drone";
+	case Command::Type::Deselect: return "deselect";
+	case Command::Type::SelectWeapon: return "select_weapon";
+	case Command::Type::SelectCrew: return "select_crew";
+	case Command::Type::SwapWeapons: return "swap_weapons";
+	case Command::Type::SwapDrones: return "swap_drones";
+	case Command::Type::CrewAbility: return "crew_ability";
+	case Command::Type::Autofire: return "autofire";
+	case Command::Type::TeleportSend: return "teleport_send";
+	case Command::Type::TeleportReturn: return "teleport_return";
+	case Command::Type::Cloak: return "cloak";
+	case Command::Type::Battery: return "battery";
+	case Command::Type::MindControl: return "mind_control";
+	case Command::Type::SetupHack: return "setup_hack";
+	case Command::Type::Hack: return "hack";
+	case Command::Type::Door: return "door";
+	case Command::Type::OpenAllDoors: return "open_all_doors";
+	case Command::Type::CloseAllDoors: return "close_all_doors";
+	case Command::Type::Aim: return "aim";
+	case Command::Type::AimBeam: return "aim_beam";
+	case Command::Type::SendCrew: return "send_crew";
+	case Command::Type::SaveStations: return "save_stations";
+	case Command::Type::LoadStations: return "load_stations";
+	case Command::Type::Jump: return "jump";
+	case Command::Type::LeaveCrew: return "leave_crew";
+	case Command::Type::Upgrades: return "upgrades";
+	case Command::Type::CrewManifest: return "crew_manifest";
+	case Command::Type::Cargo: return "cargo";
+	case Command::Type::Store: return "store";
+	case Command::Type::Menu: return "menu";
+	case Command::Type::UpgradeSystem: return "upgrade_system";
+	case Command::Type::UpgradeReactor: return "upgrade_reactor";
+	case Command::Type::UndoUpgrades: return "undo_upgrades";
+	case Command::Type::RenameCrew: return "rename_crew";
+	case Command::Type::DismissCrew: return "dismiss_crew";
+	case Command::Type::ConfirmDismissCrew: return "confirm_dismiss_crew";
+	case Command::Type::SwapCargo: return "swap_cargo";
+	case Command::Type::SwapWeaponCargo: return "swap_weapon_cargo";
+	case Command::Type::SwapDroneCargo: return "swap_drone_cargo";
+	case Command::Type::DiscardCargo: return "discard_cargo";
+	case Command::Type::DiscardWeapon: return "discard_weapon";
+	case Command::Type::DiscardDrone: return "discard_drone";
+	case Command::Type::DiscardAugment: return "discard_augment";
+	case Command::Type::BuyItem: return "buy_item";
+	case Command::Type::BuyFuel: return "buy_fuel";
+	case Command::Type::BuyMissiles: return "buy_missiles";
+	case Command::Type::BuyDroneParts: return "buy_drone_parts";
+	case Command::Type::BuyRepair: return "buy_repair";
+	case Command::Type::BuyRepairAll: return "buy_repair_all";
+	case Command::Type::ConfirmPurchase: return "confirm_purchase";
+	case Command::Type::JumpToBeacon: return "jump_to_beacon";
+	case Command::Type::OpenSectors: return "open_sectors";
+	case Command::Type::JumpToSector: return "jump_to_sector";
+	case Command::Type::CloseMenu: return "close_menu";
+	}
+
+	return "none";
+}
+
+}
+
 class Input::Impl
 {
 public:
-	static constexpr int INPUT_CAP = 1;
-
 	Impl()
 	{
 		auto&& mrs = Reader::getRawState(MutableRawState{});
@@ -205,16 +295,49 @@ public:
 
 	~Impl() = default;
 
+	// Checks if a command has to wait until the next frame
+	// The game only updates some things (what's hovered, what's selected, which menu is open)
+	// when it runs its loop, and our copy of the state is only read once per frame too
+	bool conflicts(const Command& cmd) const
+	{
+		if (this->inputsMade == 0) return false;
+
+		switch (cmd.type)
+		{
+		case Command::Type::Mouse:
+			// Clicking relies on the game having seen the cursor move first, unless fused
+			return !isMove(cmd) && this->cursorMoved && !this->fusedClicks;
+		case Command::Type::Keyboard:
+		case Command::Type::TextInput:
+		case Command::Type::TextEvent:
+			return false;
+		default:
+			// Everything else looks at the state, which is now out of date
+			return true;
+		}
+	}
+
 	void iterate()
 	{
-		int inputsMade = 0;
+		this->releaseDue();
+		this->verify();
 
-		while (inputsMade < INPUT_CAP && !this->empty())
+		this->frame++;
+		this->inputsMade = 0;
+		this->cursorMoved = false;
+		this->cursor = Reader::getState().ui.mouse.position;
+
+		while (this->inputsMade < this->budget && !this->empty())
 		{
+			this->lane = this->chooseLane();
+			if (this->conflicts(this->top())) break;
+
 			try
 			{
 				this->setImmediate();
 				auto&& cmd = this->top();
+				this->running = cmd.id;
+				if (cmd.startedAt < 0.0) cmd.startedAt = Reader::now();
 
 				switch (cmd.type)
 				{
@@ -226,24 +349,23 @@ public:
 					}
 					break;
 				case Command::Type::Mouse:
-					this->mouseInput(std::get<MouseCommand>(cmd.args));
-					inputsMade++;
+					if (this->mouseInput(std::get<MouseCommand>(cmd.args))) this->inputsMade++;
 					break;
 				case Command::Type::Keyboard:
 					this->keyboardInput(std::get<KeyboardCommand>(cmd.args));
-					inputsMade++;
+					this->inputsMade++;
 					break;
 				case Command::Type::TextInput:
-					this->textInput(std::get<char>(cmd.args));
-					inputsMade++;
+					this->textInput(std::get<TextCommand>(cmd.args));
+					this->inputsMade++;
 					break;
 				case Command::Type::TextEvent:
 					this->textEvent(std::get<raw::TextEvent>(cmd.args));
-					inputsMade++;
+					this->inputsMade++;
 					break;
 				case Command::Type::Cheat:
 					this->cheat(std::get<CheatCommand>(cmd.args));
-					inputsMade++;
+					this->inputsMade++;
 					break;
 				case Command::Type::Pause: this->pause(std::get<bool>(cmd.args)); break;
 				case Command::Type::EventChoice: this->choice(std::get<int>(cmd.args)); break;
@@ -296,7 +418,7 @@ public:
 			}
 			catch (const std::exception& e)
 			{
-				this->pop();
+				this->pop(e.what());
 				throw e;
 			}
 
@@ -304,30 +426,138 @@ public:
 		}
 	}
 
+	static bool isMove(const Command& cmd)
+	{
+		if (cmd.type != Command::Type::Mouse) return false;
+
+		auto&& mouse = std::get<MouseCommand>(cmd.args);
+		return mouse.direction == InputDirection::Unchanged || mouse.button == MouseButton::None;
+	}
+
+	// Moves straight after each other are merged, since only the last one matters
+	// Returns the id of the move it was merged into, if it was
+	static std::optional<Input::Ret> mergeMove(Command& prev, const Command& cmd)
+	{
+		if (!isMove(prev) || !isMove(cmd)) return std::nullopt;
+
+		// Moving off screen means not moving, so the previous move stands
+		auto&& pos = std::get<MouseCommand>(cmd.args).pos;
+		if (!offScreen(pos)) std::get<MouseCommand>(prev.args).pos = pos;
+
+		return prev.id;
+	}
+
 	Input::Ret push(const Command& cmd)
 	{
+		// Commands made while running another go right after it, in order
 		if (this->immediate)
 		{
-			this->immediateIt++;
-			this->immediateIt = this->queue.insert(this->immediateIt, cmd);
-			this->immediateIt->id = ++this->idCounter;
+			if (!this->expanded.empty())
+			{
+				if (auto id = mergeMove(this->expanded.back(), cmd)) return *id;
+			}
+
+			auto&& queued = this->expanded.emplace_back(cmd);
+			queued.id = ++this->idCounter;
+			queued.parent = this->running;
+			queued.queuedAt = Reader::now();
+			return this->idCounter;
+		}
+
+		Command stamped = cmd;
+		stamped.priority = this->priority;
+		stamped.tag = this->tag;
+		stamped.queuedAt = this->delay > 0.0 ? this->due : Reader::now();
+
+		if (this->delay > 0.0)
+		{
+			this->timers.push_back({ this->due, std::move(stamped) });
+			this->timers.back().cmd.id = ++this->idCounter;
+			std::push_heap(this->timers.begin(), this->timers.end(), Timer::later);
 			return this->idCounter;
 		}
 
-		this->queue.push_back(cmd);
-		this->queue.back().id = ++this->idCounter;
+		auto&& queue = this->lanes[size_t(this->priority)];
+
+		if (!queue.empty())
+		{
+			if (auto id = mergeMove(queue.back(), stamped)) return *id;
+		}
 
+		queue.push_back(std::move(stamped)).id = ++this->idCounter;
 		return this->idCounter;
 	}
 
 	bool empty() const
 	{
-		return this->queue.empty();
+		return std::all_of(this->lanes.begin(), this->lanes.end(), [](auto&& queue) { return queue.empty(); });
+	}
+
+	// The most urgent lane with anything in it
+	// Unless the current lane is in the middle of something that shouldn't be interrupted:
+	// commands queued by another command, or a mouse button that's still held
+	size_t chooseLane() const
+	{
+		auto&& current = this->lanes[this->lane];
+		bool busy = !current.empty() && (current.front().parent != 0 || this->buttonsHeld > 0);
+		if (busy) return this->lane;
+
+		for (size_t i = this->lanes.size(); i-- > 0;)
+		{
+			if (!this->lanes[i].empty()) return i;
+		}
+
+		return this->lane;
+	}
+
+	// Only commands that haven't started can be cancelled, so nothing is left half done
+	template<typename F>
+	size_t cancel(F&& which)
+	{
+		constexpr char cancelled[] = "the command was cancelled";
+		size_t count = 0;
+
+		auto check = [&](const Command& cmd) {
+			if (cmd.parent != 0 || !which(cmd)) return false;
+
+			this->record(cmd.id, cancelled);
+			count++;
+			return true;
+		};
+
+		for (auto&& queue : this->lanes)
+		{
+			queue.eraseIf(check);
+		}
+
+		auto end = std::remove_if(this->timers.begin(), this->timers.end(), [&](const Timer& timer) {
+			return check(timer.cmd);
+		});
+
+		this->timers.erase(end, this->timers.end());
+		std::make_heap(this->timers.begin(), this->timers.end(), Timer::later);
+
+		return count;
 	}
 
 	void clear()
 	{
-		this->queue.clear();
+		constexpr char cleared[] = "the command was cleared from the queue";
+
+		this->expectations.clear();
+
+		for (auto&& queue : this->lanes)
+		{
+			for (size_t i = 0; i < queue.size(); i++) this->record(queue[i].id, cleared);
+			queue.clear();
+		}
+
+		for (auto&& timer : this->timers) this->record(timer.cmd.id, cleared);
+		for (auto&& [id, expansion] : this->expansions) this->record(id, cleared);
+
+		this->expanded.clear();
+		this->timers.clear();
+		this->expansions.clear();
 	}
 
 	void unhookAll()
@@ -344,7 +574,7 @@ public:
 
 	Command& top()
 	{
-		return this->queue.front();
+		return this->lanes[this->lane].front();
 	}
 
 	Key getHotkey(const std::string& k)
@@ -361,14 +591,166 @@ public:
 		}
 	}
 
+	static const HotkeyTable& hotkeyTable()
+	{
+		return Reader::getState().settings._hotkeyTable;
+	}
+
+	Key getHotkey(Hotkey hotkey)
+	{
+		auto&& entry = hotkeyTable().named[size_t(hotkey)];
+		if (!entry) throw InvalidHotkey(hotkeyName(hotkey));
+		return *entry;
+	}
+
+	Key systemHotkey(SystemType type, bool unpower)
+	{
+		auto&& table = unpower ? hotkeyTable().systemUnpower : hotkeyTable().systemPower;
+		size_t i = size_t(type);
+
+		if (i < table.size() && table[i]) return *table[i];
+		throw InvalidHotkey(unpower ? systemUnpowerHotkey(type) : systemPowerHotkey(type));
+	}
+
+	// For hotkeys like "crew1", where index 0 is number 1
+	template<size_t N>
+	Key numberedHotkey(const std::array<HotkeyTable::Entry, N>& table, int index, const char* prefix)
+	{
+		if (index >= 0 && size_t(index) < N && table[index]) return *table[index];
+
+		// Not in the table, so look it up by name
+		return this->getHotkey(prefix + std::to_string(index + 1));
+	}
+
 private:
 	friend class Input;
-	using Queue = std::list<Command>;
-	Queue queue;
+	// One queue per priority, commands queued by another command go in the same one
+	std::array<RingBuffer<Command>, size_t(CommandPriority::Urgent) + 1> lanes;
+	size_t lane = 0; // the one being run
+	CommandPriority priority = CommandPriority::Normal;
+	std::string tag;
+	int buttonsHeld = 0;
+
 	bool immediate = false;
-	Queue::iterator immediateIt;
+	std::vector<Command> expanded; // pushed while running the top command, goes in front on pop
+
+	// Delayed commands, kept as a heap with the soonest on top
+	struct Timer
+	{
+		double time;
+		Command cmd;
+
+		// Ties keep the order they were queued in
+		static bool later(const Timer& a, const Timer& b)
+		{
+			if (a.time != b.time) return a.time > b.time;
+			return a.cmd.id > b.cmd.id;
+		}
+	};
+
+	std::vector<Timer> timers;
+	double delay = 0.0, due = 0.0;
+
+	// Commands that have run, but are waiting on the commands they queued
+	struct Timing
+	{
+		Command::Type type = Command::Type::None;
+		double queued = 0.0, started = 0.0;
+	};
+
+	struct Expansion
+	{
+		uintmax_t parent = 0;
+		size_t remaining = 0;
+		Timing timing;
+	};
+
+	std::unordered_map<uintmax_t, Expansion> expansions;
+	uintmax_t running = 0, frame = 0;
+
+	// What commands are expected to have done, by command id
+	struct Expectation
+	{
+		const char* what = nullptr;
+		std::function<bool(const State&)> check;
+		Command cmd; // for retrying it
+		int attempts = 0;
+		double started = 0.0;
+		uintmax_t startFrame = 0;
+		bool finished = false;
+		uintmax_t frame = 0; // when it finished
+	};
+
+	// The last LATENCY_SAMPLES of something, to get percentiles from
+	class Histogram
+	{
+	public:
+		void add(double sample)
+		{
+			if (this->samples.size() == Input::LATENCY_SAMPLES) this->samples.pop_front();
+			this->samples.push_back(sample);
+		}
+
+		LatencyStats stats() const
+		{
+			LatencyStats stats;
+			stats.count = this->samples.size();
+			if (stats.count == 0) return stats;
+
+			std::vector<double> sorted(stats.count);
+			for (size_t i = 0; i < stats.count; i++) sorted[i] = this->samples[i];
+			std::sort(sorted.begin(), sorted.end());
+
+			auto percentile = [&](double p) {
+				return sorted[std::min(stats.count - 1, size_t(p * double(stats.count)))];
+			};
+
+			stats.p50 = percentile(0.50);
+			stats.p95 = percentile(0.95);
+			stats.p99 = percentile(0.99);
+			stats.max = sorted.back();
+			return stats;
+		}
+
+	private:
+		RingBuffer<double> samples{ Input::LATENCY_SAMPLES };
+	};
+
+	struct Latency
+	{
+		Histogram started, finished, confirmed, confirmedFrames;
+	};
+
+	std::array<Latency, size_t(Command::Type::CloseMenu) + 1> latency;
+
+	void sample(const Timing& timing)
+	{
+		if (timing.type == Command::Type::None) return;
+
+		auto&& latency = this->latency[size_t(timing.type)];
+		latency.started.add(timing.started - timing.queued);
+		latency.finished.add(Reader::now() - timing.queued);
+	}
+
+	static constexpr uintmax_t VERIFY_FRAMES = 3;
+	std::unordered_map<uintmax_t, Expectation> expectations;
+	std::map<std::string, VerificationStats> verification;
+	int retries = 2;
+
+	// Results since they were last taken, and the most recent ones to look up
+	std::vector<CommandResult> results;
+	RingBuffer<CommandResult> recent{ Input::RESULTS_KEPT };
 	uintmax_t idCounter = 0;
 
+	// Raw inputs allowed per frame, and how many were made this frame
+	int budget = 1;
+	int inputsMade = 0;
+
+	// Where the cursor is as of the last input, and if it moved this frame
+	Point<int> cursor;
+	bool cursorMoved = false;
+	bool fusedClicks = false; // lets clicks happen in the same frame as the move before them
+
 	static constexpr uintptr_t SHIFT_STATE_ADDR = 0x178BE0;
 
 	// Hookable "function" that simply returns 1
@@ -387,30 +769,199 @@ private:
 
 	void setImmediate()
 	{
-		this->immediateIt = this->queue.begin();
 		this->immediate = true;
 	}
 
 	void resetImmediate()
 	{
-		this->immediateIt = this->queue.end();
 		this->immediate = false;
 	}
 
-	void pop()
+	// Moves delayed commands that are due onto the end of the queue
+	void releaseDue()
+	{
+		double now = Reader::now();
+
+		while (!this->timers.empty() && this->timers.front().time <= now)
+		{
+			std::pop_heap(this->timers.begin(), this->timers.end(), Timer::later);
+			auto&& cmd = this->timers.back().cmd;
+			this->lanes[size_t(cmd.priority)].push_back(std::move(cmd));
+			this->timers.pop_back();
+		}
+	}
+
+	void pop(const char* error = nullptr)
 	{
-		this->queue.pop_front();
+		uintmax_t id = this->top().id, parent = this->top().parent;
+		Timing timing{ this->top().type, this->top().queuedAt, this->top().startedAt };
+		size_t children = this->expanded.size();
+
+		auto&& queue = this->lanes[this->lane];
+		queue.pop_front();
+
+		for (auto it = this->expanded.rbegin(); it != this->expanded.rend(); ++it)
+		{
+			it->priority = CommandPriority(this->lane);
+			queue.push_front(std::move(*it));
+		}
+
+		this->expanded.clear();
 		this->resetImmediate();
+
+		// Commands that queue others only finish once those have finished
+		if (children > 0 && !error) this->expansions[id] = { parent, children, timing };
+		else this->finish(id, parent, error ? error : "", timing);
+	}
+
+	// Registers what the running command should do to the state, to be checked once it's finished
+	// Should be called right before it makes any inputs
+	void expect(const char* what, std::function<bool(const State&)> check)
+	{
+		auto&& expectation = this->expectations[this->running];
+		expectation.what = what;
+		expectation.check = std::move(check);
+		expectation.cmd = this->top();
+
+		// Retries keep when the first attempt started
+		if (expectation.attempts == 0)
+		{
+			expectation.started = Reader::now();
+			expectation.startFrame = this->frame;
+		}
+	}
+
+	// Checks finished commands had the effect they were meant to, and retries them if not
+	void verify()
+	{
+		if (this->expectations.empty()) return;
+
+		auto&& state = Reader::getState();
+		std::vector<std::pair<uintmax_t, Expectation>> retried;
+
+		for (auto it = this->expectations.begin(); it != this->expectations.end();)
+		{
+			auto&& expectation = it->second;
+
+			if (!expectation.finished)
+			{
+				++it;
+				continue;
+			}
+
+			// Retries that had nothing to do have no check, since the state was already right
+			auto&& stats = this->verification[expectation.what];
+
+			if (!expectation.check || expectation.check(state))
+			{
+				auto&& latency = this->latency[size_t(expectation.cmd.type)];
+				latency.confirmed.add(Reader::now() - expectation.cmd.queuedAt);
+				latency.confirmedFrames.add(double(this->frame - expectation.startFrame));
+
+				stats.verified++;
+				stats.latency += Reader::now() - expectation.started;
+				stats.latencyFrames += this->frame - expectation.startFrame;
+				it = this->expectations.erase(it);
+				continue;
+			}
+
+			// Give the game a few frames to catch up
+			if (this->frame - expectation.frame < VERIFY_FRAMES)
+			{
+				++it;
+				continue;
+			}
+
+			if (expectation.attempts >= this->retries)
+			{
+				stats.failed++;
+				it = this->expectations.erase(it);
+				continue;
+			}
+
+			stats.retries++;
+
+			Command cmd = expectation.cmd;
+			cmd.parent = 0;
+			cmd.id = ++this->idCounter;
+			cmd.startedAt = -1.0;
+
+			Expectation next{
+				.what = expectation.what,
+				.cmd = expectation.cmd, // keeps when the first attempt was queued
+				.attempts = expectation.attempts + 1,
+				.started = expectation.started,
+				.startFrame = expectation.startFrame
+			};
+
+			retried.emplace_back(cmd.id, std::move(next));
+			this->lanes[size_t(cmd.priority)].push_back(std::move(cmd));
+			it = this->expectations.erase(it);
+		}
+
+		for (auto&& [id, expectation] : retried)
+		{
+			this->expectations.emplace(id, std::move(expectation));
+		}
+	}
+
+	void record(uintmax_t id, const std::string& error)
+	{
+		if (auto it = this->expectations.find(id); it != this->expectations.end())
+		{
+			auto&& expectation = it->second;
+
+			if (error.empty())
+			{
+				expectation.finished = true;
+				expectation.frame = this->frame;
+			}
+			else
+			{
+				// Failing outright isn't something retrying will fix
+				if (expectation.what) this->verification[expectation.what].failed++;
+				this->expectations.erase(it);
+			}
+		}
+
+		CommandResult result{
+			.id = id,
+			.frame = this->frame,
+			.time = Reader::now(),
+			.error = error
+		};
+
+		if (this->recent.size() == Input::RESULTS_KEPT) this->recent.pop_front();
+		this->recent.push_back(result);
+		this->results.push_back(std::move(result));
+	}
+
+	// Records a command finishing, and any commands waiting on it that are now finished too
+	// If it failed, the commands waiting on it fail with the same error
+	void finish(uintmax_t id, uintmax_t parent, const std::string& error, const Timing& timing)
+	{
+		this->record(id, error);
+		if (error.empty()) this->sample(timing);
+
+		while (parent != 0)
+		{
+			auto it = this->expansions.find(parent);
+			if (it == this->expansions.end()) return; // already failed
+
+			if (error.empty() && --it->second.remaining > 0) return;
+
+			this->record(parent, error);
+			if (error.empty()) this->sample(it->second.timing);
+			parent = it->second.parent;
+			this->expansions.erase(it);
+		}
 	}
 
 	// Returns true if waiting
-	bool waiting(const WaitCommand& cmd)
+	bool waiting(WaitCommand& cmd)
 	{
-		static double base = 0.0;
-		if (base == 0.0) base = Reader::now();
-		bool res = Reader::now() < base + cmd.time;
-		if (!res) base = 0.0;
-		return res;
+		if (cmd.until < 0.0) cmd.until = Reader::now() + cmd.time;
+		return Reader::now() < cmd.until;
 	}
 
 	// Forces shift to be held, regardless of player input
@@ -431,11 +982,12 @@ private:
 		}
 	}
 
-	void mouseInput(const MouseCommand& mouse)
+	// Returns false if nothing had to be done
+	bool mouseInput(const MouseCommand& mouse)
 	{
 		auto&& mrs = Reader::getRawState({});
 		Point<int> pos = mouse.pos;
-		Point<int> old = Reader::getState().ui.mouse.position;
+		Point<int> old = this->cursor;
 
 		// Position is invalid (intentionally or not), don't move
 		if (this->offScreen(pos))
@@ -446,19 +998,27 @@ private:
 		// not clicking
 		if (mouse.direction == InputDirection::Unchanged || mouse.button == MouseButton::None)
 		{
+			// Already there
+			if (pos.x == old.x && pos.y == old.y) return false;
+
 			Point<int> offset = pos - old;
 			mrs.app->OnMouseMove(pos.x, pos.y, offset.x, offset.y, false, false, false);
 			mrs.mouseControl->lastPosition = mrs.mouseControl->position;
 			mrs.mouseControl->position.x = pos.x;
 			mrs.mouseControl->position.y = pos.y;
 
-			return; 
+			this->cursor = pos;
+			this->cursorMoved = true;
+
+			return true;
 		}
 
 		this->setShiftHeld(mouse.shift);
 
 		if (mouse.direction == InputDirection::Down)
 		{
+			this->buttonsHeld++;
+
 			switch (mouse.button)
 			{
 			case MouseButton::Left: mrs.app->OnLButtonDown(pos.x, pos.y); break;
@@ -468,6 +1028,8 @@ private:
 		}
 		else if (mouse.direction == InputDirection::Up)
 		{
+			if (this->buttonsHeld > 0) this->buttonsHeld--;
+
 			switch (mouse.button)
 			{
 			case MouseButton::Left: mrs.app->OnLButtonUp(pos.x, pos.y); break;
@@ -477,6 +1039,7 @@ private:
 		}
 
 		this->setShiftHeld(false);
+		return true;
 	}
 
 	void keyboardInput(const KeyboardCommand& keyboard)
@@ -510,10 +1073,15 @@ private:
 		if (!keyIsShift) this->setShiftHeld(false);
 	}
 
-	void textInput(char character)
+	// The game handles each character as it's given, so the whole string can go in one frame
+	void textInput(const TextCommand& cmd)
 	{
 		auto&& mrs = Reader::getRawState({});
-		mrs.app->OnTextInput(character);
+
+		for (auto&& character : cmd.text)
+		{
+			mrs.app->OnTextInput(character);
+		}
 	}
 
 	void textEvent(raw::TextEvent event)
@@ -561,67 +1129,591 @@ private:
 		if (pause.menu || pause.event) throw WrongMenu(what);
 	}
 
-	// Generic function to try a hotkey and fallback to clicking
-	// Returns true/false based on if hotkey was available
-	bool hotkeyOr(const char* hotkey, Point<int> fallback)
+	// Checks for if commands would be accepted
+	// These are the only copy of the rules: the commands run the same checks with raise set,
+	// which throws the exception the command has always thrown instead of giving the status
+	// Without raise they don't throw or queue anything, so they're cheap enough to check every possible action
+
+	template<typename F>
+	static CommandStatus reject(bool raise, CommandStatus status, F&& exception)
 	{
-		// Use if hotkey possible
-		auto k = this->getHotkey(hotkey);
+		if (raise) throw exception();
+		return status;
+	}
 
-		if (k != Key::Unknown)
+	static CommandStatus inGameStatus(const State& state, bool raise = false, const char* what = "an input")
+	{
+		if (!state.game || !state.game->playerShip)
 		{
-			Input::keyPress(k, false);
-			return true;
+			return reject(raise, CommandStatus::GameNotRunning, [&] { return GameNotRunning(what); });
 		}
 
-		Input::mouseClick(MouseButton::Left, fallback, false);
-		return false;
+		auto&& pause = state.game->pause;
+
+		if (pause.menu || pause.event)
+		{
+			return reject(raise, CommandStatus::WrongMenu, [&] { return WrongMenu(what); });
+		}
+
+		return CommandStatus::Ok;
 	}
 
-	struct PowerHotkey
+	static const Room* roomFor(const State& state, int id, bool self)
 	{
-		Key key = Key::Unknown;
-		bool shift = false;
-	};
+		auto&& ship = self ? state.game->playerShip : state.game->enemyShip;
+		if (!ship || id < 0 || size_t(id) >= ship->rooms.size()) return nullptr;
+		return &ship->rooms[id];
+	}
 
-	// Find any working keyboard combo to (un)power the system
-	PowerHotkey workingPowerHotkey(
-		const System& sys,
-		bool unpower)
+	static CommandStatus roomStatus(const State& state, int id, bool self, bool raise)
 	{
-		Key k;
+		if (roomFor(state, id, self)) return CommandStatus::Ok;
 
-		if (unpower)
-		{
-			// Try to get the direct unpower key
-			k = this->getHotkey(systemUnpowerHotkey(sys.type));
-			if (k != Key::Unknown) return { k, false };
+		return reject(raise, CommandStatus::InvalidRoom, [&] {
+			return std::range_error(self ? "room has invalid id" : "enemy room has invalid id");
+		});
+	}
 
-			// Then, fallback to positional unpower key
-			int id = sys.uiBox + 1;
-			k = this->getHotkey("un_power_" + std::to_string(id));
-			if (k != Key::Unknown) return { k, false };
+	static bool canTarget(const Weapon& weapon, const Room& room)
+	{
+		return !room.player || weapon.blueprint->type == WeaponType::Bomb;
+	}
 
-			// Then, fallback to direct power key + shift
-			k = this->getHotkey(systemPowerHotkey(sys.type));
-			if (k != Key::Unknown) return { k, true };
+	static CommandStatus checkPowerSystem(const State& state, SystemType type, int set, int which, bool raise = false)
+	{
+		if (auto status = inGameStatus(state, raise, "powering a system"); status != CommandStatus::Ok) return status;
 
-			// Then, fallback to positional power key + shift
-			k = this->getHotkey("power_" + std::to_string(id));
-			if (k != Key::Unknown) return { k, true };
+		auto&& ship = *state.game->playerShip;
 
-			// Otherwise, there's no hotkey for it
-			return { k, false };
+		if (!ship.hasSystem(type, which))
+		{
+			if (raise) ship.getSystem(type, which); // throws the right SystemNotInstalled
+			return CommandStatus::SystemNotInstalled;
 		}
 
-		// Try to get direct power key
-		k = this->getHotkey(systemPowerHotkey(sys.type));
-		if (k != Key::Unknown) return { k, false };
+		auto&& system = ship.getSystem(type, which);
+		int required = system.power.required;
 
-		// Then, fallback to positional power 
-		int id = sys.uiBox + 1;
-		k = this->getHotkey("power_" + std::to_string(id));
-		if (k != Key::Unknown) return { k, false };
+		if (required <= 0 || required > 2)
+		{
+			return reject(raise, CommandStatus::InvalidPower, [&] {
+				return InvalidPowerRequest(system, "this function can't handle that system");
+			});
+		}
+
+		if (system.subsystem())
+		{
+			return reject(raise, CommandStatus::InvalidPower, [&] {
+				return InvalidPowerRequest(system, "subsystem power cannot be controlled");
+			});
+		}
+
+		// Nothing to do
+		int current = system.power.total.first;
+		if (current == set) return CommandStatus::Ok;
+
+		auto range = system.powerRange();
+
+		if (set < range.first || set > range.second)
+		{
+			return reject(raise, CommandStatus::InvalidPower, [&] {
+				return InvalidPowerRequest(system, set, range);
+			});
+		}
+
+		// Power must be between a multiple and a multiple + zoltan power present
+		int mod = set % required;
+
+		if (mod > system.power.zoltan)
+		{
+			return reject(raise, CommandStatus::InvalidPower, [&] {
+				return InvalidPowerRequest(system, set, required);
+			});
+		}
+
+		if (set > current)
+		{
+			// Going up to an odd level would take powering up then down again
+			if (mod != 0)
+			{
+				return reject(raise, CommandStatus::InvalidPower, [&] {
+					return InvalidPowerRequest(system, "it can't be powered up to a level between multiples");
+				});
+			}
+
+			int end = required > 1 ? ((set + 1) / required) * required : set;
+
+			if (end - current > ship.reactor.total.first)
+			{
+				return reject(raise, CommandStatus::NotEnoughPower, [&] {
+					return InvalidPowerRequest(system, "there isn't enough power in the reactor");
+				});
+			}
+		}
+
+		return CommandStatus::Ok;
+	}
+
+	static CommandStatus checkWeaponSlot(const State& state, int slot, bool raise, const char* what)
+	{
+		if (auto status = inGameStatus(state, raise, what); status != CommandStatus::Ok) return status;
+
+		auto&& weapons = state.game->playerShip->weapons;
+
+		if (!weapons)
+		{
+			return reject(raise, CommandStatus::SystemNotInstalled, [] { return SystemNotInstalled(SystemType::Weapons); });
+		}
+
+		int slots = int(weapons->list.size());
+
+		if (slot < 0)
+		{
+			return reject(raise, CommandStatus::InvalidSlot, [&] { return InvalidSlotChoice("weapon", slot); });
+		}
+
+		if (slot >= slots)
+		{
+			return reject(raise, CommandStatus::InvalidSlot, [&] { return InvalidSlotChoice("weapon", slot, slots); });
+		}
+
+		return CommandStatus::Ok;
+	}
+
+	static CommandStatus checkPowerWeapon(const State& state, int slot, bool on, bool raise = false)
+	{
+		if (auto status = checkWeaponSlot(state, slot, raise, "powering a weapon"); status != CommandStatus::Ok) return status;
+
+		auto&& ship = *state.game->playerShip;
+		auto&& weapSys = *ship.weapons;
+		auto&& weapon = weapSys.list[slot];
+
+		auto range = weapSys.powerRange();
+		int current = weapon.power.total.first;
+
+		if (range.first == range.second)
+		{
+			return reject(raise, CommandStatus::InvalidPower, [&] {
+				int desired = current + weapon.power.required * (on ? 1 : -1);
+				return InvalidPowerRequest(weapSys, desired, range);
+			});
+		}
+
+		if (on)
+		{
+			// Nothing needs to be done
+			int needs = weapon.power.required - current;
+			if (needs == 0) return CommandStatus::Ok;
+
+			if (ship.cargo.missiles < weapon.blueprint->missiles)
+			{
+				return reject(raise, CommandStatus::NotEnoughMissiles, [&] {
+					return InvalidSlotChoice("weapon", weapon.slot, "there isn't enough missiles");
+				});
+			}
+
+			if (needs > ship.reactor.total.first)
+			{
+				return reject(raise, CommandStatus::NotEnoughPower, [&] {
+					return InvalidPowerRequest(weapon, "there isn't enough power in the reactor");
+				});
+			}
+
+			if (needs > weapSys.power.total.second - weapSys.power.total.first)
+			{
+				return reject(raise, CommandStatus::NotEnoughPower, [&] {
+					return InvalidPowerRequest(weapon, "there isn't enough power in the weapon system");
+				});
+			}
+
+			return CommandStatus::Ok;
+		}
+
+		// Nothing needs to be done
+		int del = current - weapon.power.zoltan;
+		if (del == 0) return CommandStatus::Ok;
+
+		if (weapon.power.zoltan >= weapon.power.required)
+		{
+			return reject(raise, CommandStatus::ZoltanPowered, [&] {
+				return InvalidPowerRequest(weapon, "it is fully powered by zoltan crew");
+			});
+		}
+
+		return CommandStatus::Ok;
+	}
+
+	static CommandStatus checkSelectWeapon(const State& state, int slot, bool raise = false)
+	{
+		if (auto status = checkWeaponSlot(state, slot, raise, "selecting a weapon"); status != CommandStatus::Ok) return status;
+
+		auto&& weapon = state.game->playerShip->weapons->list[slot];
+
+		if (!weapon.powered())
+		{
+			return reject(raise, CommandStatus::NotPowered, [&] {
+				return InvalidSlotChoice("weapon", weapon.slot, "it is not powered");
+			});
+		}
+
+		return CommandStatus::Ok;
+	}
+
+	// Selecting the weapon, then aiming it at the room
+	// There's no single command for this, so it's only ever checked
+	static CommandStatus checkAimWeapon(const State& state, int slot, int room, bool self)
+	{
+		if (auto status = checkSelectWeapon(state, slot); status != CommandStatus::Ok) return status;
+
+		auto target = roomFor(state, room, self);
+		if (!target) return CommandStatus::InvalidRoom;
+		if (!canTarget(state.game->playerShip->weapons->list[slot], *target)) return CommandStatus::InvalidSelfAim;
+
+		return CommandStatus::Ok;
+	}
+
+	// Aiming whatever is selected at the room
+	static CommandStatus checkAim(const State& state, int room, bool self, bool autofire = false, bool raise = false)
+	{
+		if (auto status = inGameStatus(state, raise, "aiming weapon/system"); status != CommandStatus::Ok) return status;
+		if (auto status = roomStatus(state, room, self, raise); status != CommandStatus::Ok) return status;
+
+		auto&& target = *roomFor(state, room, self);
+		auto&& aiming = state.ui.mouse.aiming;
+
+		if (std::holds_alternative<SystemUIRef>(aiming))
+		{
+			auto&& system = std::get<SystemUIRef>(aiming).get();
+
+			if (system.type == SystemType::MindControl)
+			{
+				if (!target.mindControllable())
+				{
+					return reject(raise, CommandStatus::InvalidSelfAim, [] {
+						return InvalidSelfAim("mind control requires a visible room with intruding crew");
+					});
+				}
+			}
+			else if (target.player)
+			{
+				return reject(raise, CommandStatus::InvalidSelfAim, [] {
+					return InvalidSelfAim("only mind control can do that");
+				});
+			}
+
+			if (autofire)
+			{
+				return reject(raise, CommandStatus::InvalidArgument, [] {
+					return std::invalid_argument("cannot specify autofire for a system");
+				});
+			}
+
+			return CommandStatus::Ok;
+		}
+
+		if (std::holds_alternative<WeaponUIRef>(aiming))
+		{
+			if (!canTarget(std::get<WeaponUIRef>(aiming).get(), target))
+			{
+				return reject(raise, CommandStatus::InvalidSelfAim, [] {
+					return InvalidSelfAim("only bomb weapons can do that");
+				});
+			}
+
+			return CommandStatus::Ok;
+		}
+
+		return reject(raise, CommandStatus::NotSelected, [] { return NotSelected("weapon/system"); });
+	}
+
+	static CommandStatus checkSendCrew(const State& state, int room, bool self, bool raise = false)
+	{
+		if (auto status = inGameStatus(state, raise, "sending crew to a room"); status != CommandStatus::Ok) return status;
+		if (auto status = roomStatus(state, room, self, raise); status != CommandStatus::Ok) return status;
+
+		// Only the selected crew matter, anyone else can be wherever they like
+		const Crew* selected = nullptr;
+		const Crew* wrongShip = nullptr;
+
+		for (auto&& c : state.game->playerCrew)
+		{
+			if (c.selectionId < 0) continue;
+
+			if (!selected) selected = &c;
+			if (!wrongShip && c.onPlayerShip != self) wrongShip = &c;
+		}
+
+		if (!selected)
+		{
+			return reject(raise, CommandStatus::NotSelected, [] { return NotSelected("crewmember"); });
+		}
+
+		if (wrongShip)
+		{
+			return reject(raise, CommandStatus::WrongShip, [&] {
+				return InvalidCrewChoice(*wrongShip, "they're on the wrong ship");
+			});
+		}
+
+		return CommandStatus::Ok;
+	}
+
+	static CommandStatus checkDoor(const State& state, int id, bool open, bool raise = false)
+	{
+		if (auto status = inGameStatus(state, raise, "toggling a door"); status != CommandStatus::Ok) return status;
+
+		auto&& ship = *state.game->playerShip;
+		auto&& doors = ship.doorControl;
+
+		if (!doors)
+		{
+			return reject(raise, CommandStatus::SystemNotInstalled, [] { return SystemNotInstalled(SystemType::Doors); });
+		}
+
+		if (id < 0 || size_t(id) >= ship.doors.size())
+		{
+			return reject(raise, CommandStatus::InvalidSlot, [] { return std::range_error("door has invalid id"); });
+		}
+
+		// These are checked even if the door is already how it should be
+		auto&& door = ship.doors[id];
+		const char* why = nullptr;
+
+		if (!doors->operable()) why = "the door system is inoperable";
+		else if (!door.player) why = "it does not belong to the player";
+		else if (door.openFake) why = "has crew standing in it";
+
+		if (why)
+		{
+			return reject(raise, CommandStatus::DoorInoperable, [&] { return DoorInoperable(door, why); });
+		}
+
+		return CommandStatus::Ok;
+	}
+
+	static CommandStatus checkChoice(const State& state, int which, bool raise = false)
+	{
+		constexpr char act[] = "picking an event choice";
+
+		if (!state.game)
+		{
+			return reject(raise, CommandStatus::GameNotRunning, [&] { return GameNotRunning(act); });
+		}
+
+		if (!state.game->event || !state.game->pause.event || !state.ui.game || !state.ui.game->event)
+		{
+			return reject(raise, CommandStatus::NoEvent, [] { return NoEvent(); });
+		}
+
+		auto&& event = *state.ui.game->event;
+
+		if (which < 0 || size_t(which) >= event.choices.size())
+		{
+			return reject(raise, CommandStatus::InvalidChoice, [&] {
+				return InvalidEventChoice(which, int(event.choices.size()));
+			});
+		}
+
+		// Hotkeys disabled, must click...
+		// With the brief delay setting, the command waits until the choice can be picked
+		bool noHotkeys = state.settings.eventChoiceSelection != EventChoiceSelection::DisableHotkeys;
+		bool delay = state.settings.eventChoiceSelection != EventChoiceSelection::BriefDelay;
+
+		if (noHotkeys || (delay && event.openTime.first > 0.f))
+		{
+			if (!delay && offScreen(event.choices[which].box.topCenter()))
+			{
+				return reject(raise, CommandStatus::InvalidChoice, [&] {
+					return InvalidEventChoice(which, "hotkeys are disabled and the choice is off-screen");
+				});
+			}
+		}
+
+		return CommandStatus::Ok;
+	}
+
+	static CommandStatus checkSwapWeapons(const State& state, int a, int b, bool raise = false)
+	{
+		constexpr char act[] = "swapping equipped weapons";
+
+		if (!state.game || !state.game->playerShip)
+		{
+			return reject(raise, CommandStatus::GameNotRunning, [&] { return GameNotRunning(act); });
+		}
+
+		if (!state.ui.game || (state.game->pause.menu && !state.ui.game->cargo))
+		{
+			return reject(raise, CommandStatus::WrongMenu, [&] { return WrongMenu(act); });
+		}
+
+		if (!state.game->playerShip->weapons)
+		{
+			return reject(raise, CommandStatus::SystemNotInstalled, [] { return SystemNotInstalled(SystemType::Weapons); });
+		}
+
+		auto&& boxes = state.ui.game->cargo
+			? state.ui.game->cargo->weapons
+			: state.ui.game->weaponBoxes;
+
+		// Either slot can be empty, but not both
+		int count = int(state.game->playerShip->weapons->list.size());
+		bool invalid = a < 0 || a >= int(boxes.size()) || b < 0 || b >= int(boxes.size());
+
+		if (invalid || (a >= count && b >= count))
+		{
+			return reject(raise, CommandStatus::InvalidSwap, [&] { return InvalidSwap("weapon", a, "weapon", b); });
+		}
+
+		return CommandStatus::Ok;
+	}
+
+	static CommandStatus checkDiscardCargo(const State& state, int which, bool raise = false)
+	{
+		constexpr char act[] = "discarding cargo";
+
+		if (!state.game || !state.game->playerShip)
+		{
+			return reject(raise, CommandStatus::GameNotRunning, [&] { return GameNotRunning(act); });
+		}
+
+		if (!state.ui.game || !state.ui.game->cargo || !state.ui.game->cargo->discard)
+		{
+			return reject(raise, CommandStatus::WrongMenu, [&] { return WrongMenu(act); });
+		}
+
+		auto&& storage = state.game->playerShip->cargo.storage;
+		int storageCount = int(storage.size());
+
+		if (which < 0)
+		{
+			return reject(raise, CommandStatus::InvalidSlot, [&] { return InvalidSlotChoice("storage slot", which); });
+		}
+
+		if (which >= storageCount)
+		{
+			return reject(raise, CommandStatus::InvalidSlot, [&] {
+				return InvalidSlotChoice("storage slot", which, storageCount);
+			});
+		}
+
+		if (std::holds_alternative<std::monostate>(storage[which]))
+		{
+			return reject(raise, CommandStatus::EmptySlot, [&] { return InvalidSlotChoice("cargo", which); });
+		}
+
+		return CommandStatus::Ok;
+	}
+
+	static bool ok(CommandStatus status)
+	{
+		return status == CommandStatus::Ok;
+	}
+
+	static void legalActions(const State& state, LegalActions& out)
+	{
+		out = LegalActions{};
+
+		for (size_t type = 0; type < LegalActions::SYSTEMS; type++)
+		{
+			for (int level = 0; level <= LegalActions::MAX_POWER; level++)
+			{
+				out.power[type][level] = ok(checkPowerSystem(state, SystemType(type), level, 0));
+			}
+		}
+
+		for (int slot = 0; slot < LegalActions::MAX_WEAPONS; slot++)
+		{
+			out.weaponPower[slot][0] = ok(checkPowerWeapon(state, slot, false));
+			out.weaponPower[slot][1] = ok(checkPowerWeapon(state, slot, true));
+
+			for (int ship = 0; ship < 2; ship++)
+			{
+				for (int room = 0; room < LegalActions::MAX_ROOMS; room++)
+				{
+					out.aimWeapon[slot][ship][room] = ok(checkAimWeapon(state, slot, room, ship == 0));
+				}
+			}
+		}
+
+		for (int ship = 0; ship < 2; ship++)
+		{
+			for (int room = 0; room < LegalActions::MAX_ROOMS; room++)
+			{
+				out.sendCrew[ship][room] = ok(checkSendCrew(state, room, ship == 0));
+			}
+		}
+
+		for (int door = 0; door < LegalActions::MAX_DOORS; door++)
+		{
+			out.door[door][0] = ok(checkDoor(state, door, false));
+			out.door[door][1] = ok(checkDoor(state, door, true));
+		}
+
+		for (int choice = 0; choice < LegalActions::MAX_CHOICES; choice++)
+		{
+			out.choice[choice] = ok(checkChoice(state, choice));
+		}
+	}
+
+	// Generic function to try a hotkey and fallback to clicking
+	// Returns true/false based on if hotkey was available
+	bool hotkeyOr(Hotkey hotkey, Point<int> fallback)
+	{
+		// Use if hotkey possible
+		auto k = this->getHotkey(hotkey);
+
+		if (k != Key::Unknown)
+		{
+			Input::keyPress(k, false);
+			return true;
+		}
+
+		Input::mouseClick(MouseButton::Left, fallback, false);
+		return false;
+	}
+
+	struct PowerHotkey
+	{
+		Key key = Key::Unknown;
+		bool shift = false;
+	};
+
+	// Find any working keyboard combo to (un)power the system
+	PowerHotkey workingPowerHotkey(
+		const System& sys,
+		bool unpower)
+	{
+		Key k;
+
+		if (unpower)
+		{
+			// Try to get the direct unpower key
+			k = this->systemHotkey(sys.type, true);
+			if (k != Key::Unknown) return { k, false };
+
+			// Then, fallback to positional unpower key
+			k = this->numberedHotkey(hotkeyTable().unpower, sys.uiBox, "un_power_");
+			if (k != Key::Unknown) return { k, false };
+
+			// Then, fallback to direct power key + shift
+			k = this->systemHotkey(sys.type, false);
+			if (k != Key::Unknown) return { k, true };
+
+			// Then, fallback to positional power key + shift
+			k = this->numberedHotkey(hotkeyTable().power, sys.uiBox, "power_");
+			if (k != Key::Unknown) return { k, true };
+
+			// Otherwise, there's no hotkey for it
+			return { k, false };
+		}
+
+		// Try to get direct power key
+		k = this->systemHotkey(sys.type, false);
+		if (k != Key::Unknown) return { k, false };
+
+		// Then, fallback to positional power 
+		k = this->numberedHotkey(hotkeyTable().power, sys.uiBox, "power_");
+		if (k != Key::Unknown) return { k, false };
 
 		// Otherwise, there's no hotkey for it
 		return { k, false };
@@ -630,7 +1722,7 @@ private:
 
 	Key crewHotkey(int which)
 	{
-		return this->getHotkey("crew" + std::to_string(which + 1));
+		return this->numberedHotkey(hotkeyTable().crew, which, "crew");
 	}
 
 	// Assumes a bunch of other checks have already been made
@@ -683,17 +1775,11 @@ private:
 	void choice(int which)
 	{
 		auto&& state = Reader::getState();
-		if (!state.game) throw GameNotRunning("picking an event choice");
-		if (!state.game->event || !state.game->pause.event) throw NoEvent();
+		checkChoice(state, which, true);
 
 		auto&& event = state.ui.game->event;
 		auto&& choices = event->choices;
 
-		if (size_t(which) >= choices.size())
-		{
-			throw InvalidEventChoice(which, int(choices.size()));
-		}
-
 		// Hotkeys disabled, must click...
 		bool noHotkeys = state.settings.eventChoiceSelection != EventChoiceSelection::DisableHotkeys;
 		bool delay = state.settings.eventChoiceSelection != EventChoiceSelection::BriefDelay;
@@ -702,16 +1788,12 @@ private:
 			auto&& choice = choices.at(which);
 			bool topCenter = !impl.offScreen(choice.box.topCenter());
 
+			// The check already rejected this if there's no delay to wait out
 			if (!topCenter)
 			{
-				if (delay)
-				{
-					Input::wait(event->openTime.first);
-					Input::choice(which);
-					return;
-				}
-
-				throw InvalidEventChoice(which, "hotkeys are disabled and the choice is off-screen");
+				Input::wait(event->openTime.first);
+				Input::choice(which);
+				return;
 			}
 
 			bool center = !impl.offScreen(choice.box.center());
@@ -734,45 +1816,20 @@ private:
 	{
 		auto&& [type, set, which] = power;
 
-		this->checkInGame("powering a system");
-
 		auto&& state = Reader::getState();
+		checkPowerSystem(state, type, set, which, true);
+
 		auto&& system = state.game->playerShip->getSystem(type, which);
 
 		int required = system.power.required;
-
-		if (required <= 0 || required > 2)
-		{
-			throw InvalidPowerRequest(system, "this function can't handle that system");
-		}
-
-		if (system.subsystem())
-		{
-			throw InvalidPowerRequest(system, "subsystem power cannot be controlled");
-		}
-
 		int current = system.power.total.first;
 
 		// Nothing to do
 		if (current == set) return;
 
 		int delta = set - current;
-
-		auto range = system.powerRange();
-		if (set < range.first || set > range.second)
-		{
-			throw InvalidPowerRequest(system, set, range);
-		}
-
-		int mod = set % required;
 		int zoltan = system.power.zoltan;
 
-		// Power must be between a multiple and a multiple + zoltan power present
-		if (mod > zoltan)
-		{
-			throw InvalidPowerRequest(system, set, required);
-		}
-
 		int upInputs = 0;
 		int downInputs = 0;
 
@@ -791,15 +1848,14 @@ private:
 			int start = required > 1 ? (current / required) * required : current;
 			int end = required > 1 ? ((set + 1) / required) * required : set;
 			upInputs = (end - start) / required;
-			if (mod != 0) downInputs = 1;
-
-			if (end - current > state.game->playerShip->reactor.total.first)
-			{
-				 throw InvalidPowerRequest(system, "there isn't enough power in the reactor");
-			}
 		}
 
-		if (upInputs && downInputs) return;
+		this->expect("power_system", [type, set, which](const State& state) {
+			if (!state.game || !state.game->playerShip) return false;
+			auto&& ship = *state.game->playerShip;
+			return ship.hasSystem(type, which) && ship.getSystem(type, which).power.total.first == set;
+		});
+
 		this->deselect();
 
 		auto doInput = [&](const PowerHotkey& k, bool depower) {
@@ -836,11 +1892,10 @@ private:
 	// Assumes a bunch of other checks have already been made
 	void useWeapon(const Weapon& weapon, bool powerOff = false)
 	{
-		auto&& hotkeys = Input::hotkeys();
 		this->deselect();
 
 		// Try to use a hotkey
-		auto hotkey = getHotkey("weapon" + std::to_string(weapon.slot + 1));
+		auto hotkey = this->numberedHotkey(hotkeyTable().weapons, weapon.slot, "weapon");
 
 		// If there is none, use the mouse
 		if (hotkey == Key::Unknown)
@@ -867,63 +1922,22 @@ private:
 	{
 		auto&& [slot, on] = cmd;
 
-		this->checkInGame("powering a weapon");
-
 		auto&& state = Reader::getState();
-		if (!state.game->playerShip->weapons) throw SystemNotInstalled(SystemType::Weapons);
-
-		auto&& weapSys = *state.game->playerShip->weapons;
-		auto slots = int(weapSys.list.size());
-		if (slot < 0) throw InvalidSlotChoice("weapon", slot);
-		if (slot >= slots) throw InvalidSlotChoice("weapon", slot, slots);
-		auto&& weapon = weapSys.list[slot];
+		checkPowerWeapon(state, slot, on, true);
 
-		auto range = weapSys.powerRange();
+		auto&& weapon = state.game->playerShip->weapons->list[slot];
 		int current = weapon.power.total.first;
-		if (range.first == range.second)
-		{
-			int desired = current + weapon.power.required * (on ? 1 : -1);
-			throw InvalidPowerRequest(weapSys, desired, range);
-		}
-
-		if (on)
-		{
-			int needs = weapon.power.required - current;
-
-			// Nothing needs to be done
-			if (needs == 0) return;
-
-			// Need missiles
-			int missiles = state.game->playerShip->cargo.missiles;
-			int neededMissiles = weapon.blueprint.missiles;
-			if (missiles < neededMissiles)
-			{
-				throw InvalidSlotChoice("weapon", weapon.slot, "there isn't enough missiles");
-			}
-
-			if (needs > state.game->playerShip->reactor.total.first)
-			{
-				throw InvalidPowerRequest(weapon, "there isn't enough power in the reactor");
-			}
-
-			int remaining = weapSys.power.total.second - weapSys.power.total.first;
-			if (needs > remaining)
-			{
-				throw InvalidPowerRequest(weapon, "there isn't enough power in the weapon system");
-			}
-		}
-		else
-		{
-			int del = current - weapon.power.zoltan;
 
-			// Nothing needs to be done
-			if (del == 0) return;
+		// Nothing needs to be done
+		if (current == (on ? weapon.power.required : weapon.power.zoltan)) return;
 
-			if (weapon.power.zoltan >= weapon.power.required)
-			{
-				throw InvalidPowerRequest(weapon, "it is fully powered by zoltan crew");
-			}
-		}
+		this->expect("power_weapon", [slot, on](const State& state) {
+			if (!state.game || !state.game->playerShip || !state.game->playerShip->weapons) return false;
+			auto&& list = state.game->playerShip->weapons->list;
+			if (size_t(slot) >= list.size()) return false;
+			auto&& power = list[slot].power;
+			return power.total.first == (on ? power.required : power.zoltan);
+		});
 
 		this->useWeapon(weapon, !on);
 	}
@@ -931,11 +1945,10 @@ private:
 	// Assumes a bunch of other checks have already been made
 	void useDrone(const Drone& drone, bool powerOff = false)
 	{
-		auto&& hotkeys = Input::hotkeys();
 		this->deselect();
 
 		// Try to use a hotkey
-		auto hotkey = getHotkey("drone" + std::to_string(drone.slot + 1));
+		auto hotkey = this->numberedHotkey(hotkeyTable().drones, drone.slot, "drone");
 
 		// If there is none, use the mouse
 		if (hotkey == Key::Unknown)
@@ -1073,20 +2086,10 @@ private:
 	{
 		auto&& slot = cmd.weapon;
 
-		this->checkInGame("selecting a weapon");
-
 		auto&& state = Reader::getState();
-		if (!state.game->playerShip->weapons) throw SystemNotInstalled(SystemType::Weapons);
-
-		auto&& weapSys = *state.game->playerShip->weapons;
-		auto slots = int(weapSys.list.size());
-		if (slot < 0) throw InvalidSlotChoice("weapon", slot);
-		if (slot >= slots) throw InvalidSlotChoice("weapon", slot, slots);
-		auto&& weapon = weapSys.list[slot];
-
-		if (!weapon.powered()) throw InvalidSlotChoice("weapon", weapon.slot, "it is not powered");
+		checkSelectWeapon(state, slot, true);
 
-		useWeapon(weapon, false);
+		useWeapon(state.game->playerShip->weapons->list[slot], false);
 	}
 
 	void selectCrew(const CrewSelectionCommand& cmd)
@@ -1117,6 +2120,19 @@ private:
 			if (!c.player) throw InvalidCrewChoice(c, "they're an enemy");
 		}
 
+		this->expect("select_crew", [crew](const State& state) {
+			if (!state.game) return false;
+			auto&& list = state.game->playerCrew;
+
+			for (size_t i = 0; i < list.size(); i++)
+			{
+				bool wanted = std::find(crew.begin(), crew.end(), int(i)) != crew.end();
+				if ((list[i].selectionId >= 0) != wanted) return false;
+			}
+
+			return true;
+		});
+
 		CrewRefList group;
 		group.reserve(crew.size());
 		int prev = crew[0] - 1;
@@ -1144,7 +2160,7 @@ private:
 			if (group.size() == state.ui.game->crewBoxes.size())
 			{
 				// Selecting all crew in order, use if hotkey possible
-				auto hotkey = this->getHotkey("crew_all");
+				auto hotkey = this->getHotkey(Hotkey::CrewAll);
 
 				if (hotkey != Key::Unknown)
 				{
@@ -1160,30 +2176,15 @@ private:
 
 	void swapWeapons(const SwapCommand& cmd)
 	{
-		constexpr char act[] = "swapping equipped weapons";
+		auto&& [a, b] = cmd;
 
 		auto&& state = Reader::getState();
-		if (!state.game) throw GameNotRunning(act);
-		if (state.game->pause.menu && !state.ui.game->cargo) throw WrongMenu(act);
-		if (!state.game->playerShip->weapons) throw SystemNotInstalled(SystemType::Weapons);
+		checkSwapWeapons(state, a, b, true);
 
 		auto&& weapons = state.ui.game->cargo
 			? state.ui.game->cargo->weapons
 			: state.ui.game->weaponBoxes;
 
-		auto&& [a, b] = cmd;
-		if (a < 0 || a >= int(weapons.size()) || b < 0 || b >= int(weapons.size()))
-		{
-			throw InvalidSwap("weapon", a, "weapon", b);
-		}
-
-		bool aEmpty = a >= int(state.game->playerShip->weapons->list.size());
-		bool bEmpty = b >= int(state.game->playerShip->weapons->list.size());
-		if (aEmpty && bEmpty)
-		{
-			throw InvalidSwap("weapon", a, "weapon", b);
-		}
-
 		if (a == b) return; // do nothing, no swap needed
 
 		Input::mouseDown(MouseButton::Left, weapons[a].center());
@@ -1228,7 +2229,7 @@ private:
 		auto&& state = Reader::getState();
 		
 		// Try to use a hotkey
-		auto hotkey = getHotkey("lockdown");
+		auto hotkey = getHotkey(Hotkey::Lockdown);
 
 		if (hotkey != Key::Unknown)
 		{
@@ -1269,7 +2270,7 @@ private:
 			return;
 		}
 
-		this->hotkeyOr("autofire", state.ui.game->autofire->center());
+		this->hotkeyOr(Hotkey::Autofire, state.ui.game->autofire->center());
 	}
 
 	void teleportSend()
@@ -1287,7 +2288,7 @@ private:
 		if (!tele.canSend) throw SystemInoperable(tele, "it cannot send crew right now");
 
 		this->deselect();
-		this->hotkeyOr("send_tele", state.ui.game->teleportSend->center());
+		this->hotkeyOr(Hotkey::SendTeleport, state.ui.game->teleportSend->center());
 	}
 
 	void teleportReturn()
@@ -1305,7 +2306,7 @@ private:
 		if (!tele.canReceive) throw SystemInoperable(tele, "it cannot receive crew right now");
 
 		this->deselect();
-		this->hotkeyOr("ret_tele", state.ui.game->teleportSend->center());
+		this->hotkeyOr(Hotkey::ReturnTeleport, state.ui.game->teleportSend->center());
 	}
 
 	void cloak()
@@ -1322,7 +2323,7 @@ private:
 		if (!cloak.operable()) throw SystemInoperable(cloak);
 
 		this->deselect();
-		this->hotkeyOr("activate_cloak", state.ui.game->startCloak->center());
+		this->hotkeyOr(Hotkey::ActivateCloak, state.ui.game->startCloak->center());
 	}
 
 	void battery()
@@ -1339,7 +2340,7 @@ private:
 		if (!battery.operable()) throw SystemInoperable(battery);
 
 		this->deselect();
-		this->hotkeyOr("activate_battery", state.ui.game->startBattery->center());
+		this->hotkeyOr(Hotkey::ActivateBattery, state.ui.game->startBattery->center());
 	}
 
 	void mindControl()
@@ -1356,7 +2357,7 @@ private:
 		if (!mindControl.operable()) throw SystemInoperable(mindControl);
 
 		this->deselect();
-		this->hotkeyOr("mindControl", state.ui.game->startMindControl->center());
+		this->hotkeyOr(Hotkey::MindControl, state.ui.game->startMindControl->center());
 	}
 
 	void setupHack()
@@ -1378,7 +2379,7 @@ private:
 		}
 
 		this->deselect();
-		this->hotkeyOr("start_hacking", state.ui.game->startHack->center());
+		this->hotkeyOr(Hotkey::StartHacking, state.ui.game->startHack->center());
 	}
 
 	void hack()
@@ -1399,31 +2400,30 @@ private:
 			throw InvalidHackingInput(false, "the drone is not set up");
 		}
 
-		this->hotkeyOr("start_hacking", state.ui.game->startHack->center());
+		this->hotkeyOr(Hotkey::StartHacking, state.ui.game->startHack->center());
 	}
 
 	void doorToggle(const DoorCommand& cmd)
 	{
 		auto&& [id, open] = cmd;
 
-		this->checkInGame("toggling a door");
 		auto&& state = Reader::getState();
+		checkDoor(state, id, open, true);
 
-		auto&& doors = state.game->playerShip->doorControl;
-		if (!doors) throw SystemNotInstalled(SystemType::Doors);
-		if (size_t(id) >= state.game->playerShip->doors.size()) throw std::range_error("door has invalid id");
 		auto&& door = state.game->playerShip->doors[id];
 
-		if (!doors->operable()) throw DoorInoperable(door, "the door system is inoperable");
-		if (!door.player) throw DoorInoperable(door, "it does not belong to the player");
-		if (door.openFake) throw DoorInoperable(door, "has crew standing in it");
-
 		if (door.open == open)
 		{
 			// nothing to do
 			return;
 		}
 
+		this->expect("door", [id, open](const State& state) {
+			if (!state.game || !state.game->playerShip) return false;
+			auto&& doors = state.game->playerShip->doors;
+			return size_t(id) < doors.size() && doors[id].open == open;
+		});
+
 		Input::mouseClick(MouseButton::Left, door.rect.center(), false);
 	}
 
@@ -1459,10 +2459,10 @@ private:
 		if (airlocks && !onlyAirlocksClosed)
 		{
 			// Tap the button again
-			this->hotkeyOr("open", p);
+			this->hotkeyOr(Hotkey::OpenDoors, p);
 		}
 
-		this->hotkeyOr("open", p);
+		this->hotkeyOr(Hotkey::OpenDoors, p);
 	}
 
 	void closeAllDoors()
@@ -1492,49 +2492,17 @@ private:
 			return;
 		}
 
-		this->hotkeyOr("close", state.ui.game->closeAllDoors->center());
+		this->hotkeyOr(Hotkey::CloseDoors, state.ui.game->closeAllDoors->center());
 	}
 
 	void sendCrew(const SendCrewCommand& cmd)
 	{
 		auto&& [id, self] = cmd;
 
-		this->checkInGame("sending crew to a room");
 		auto&& state = Reader::getState();
+		checkSendCrew(state, id, self, true);
 
-		if (self && size_t(id) >= state.game->playerShip->rooms.size())
-		{
-			throw std::range_error("room has invalid id");
-		}
-
-		auto&& enemy = state.game->enemyShip;
-		if (!self && (!enemy || size_t(id) >= enemy->rooms.size()))
-		{
-			throw std::range_error("enemy room has invalid id");
-		}
-
-		const Room& room = self
-			? state.game->playerShip->rooms[id]
-			: state.game->enemyShip->rooms[id];
-
-		bool anyCrew = false;
-		for (auto&& c : state.game->playerCrew)
-		{
-			if (c.selectionId >= 0)
-			{
-				anyCrew = true;
-				break;
-			}
-
-			if (c.onPlayerShip != self)
-			{
-				throw InvalidCrewChoice(c, "they're on the wrong ship");
-			}
-		}
-
-		if (!anyCrew) throw NotSelected("crewmember");
-
-		Input::mouseClick(MouseButton::Right, room.rect.center(), false);
+		Input::mouseClick(MouseButton::Right, roomFor(state, id, self)->rect.center(), false);
 	}
 
 	// to: nullopt - inherit, true - on, false - off
@@ -1552,7 +2520,7 @@ private:
 		}
 
 		// Use if hotkey possible
-		auto k = this->getHotkey("force_autofire");
+		auto k = this->getHotkey(Hotkey::ForceAutofire);
 
 		if (k != Key::Unknown)
 		{
@@ -1570,63 +2538,11 @@ private:
 		auto&& self = aim.self;
 		auto&& autofire = aim.autofire;
 
-		this->checkInGame("aiming weapon/system");
 		auto&& state = Reader::getState();
+		checkAim(state, id, self, autofire.has_value(), true);
 
-		if (self && size_t(id) >= state.game->playerShip->rooms.size())
-		{
-			throw std::range_error("room has invalid id");
-		}
-
-		auto&& enemy = state.game->enemyShip;
-		if (!self && (!enemy || size_t(id) >= enemy->rooms.size()))
-		{
-			throw std::range_error("enemy room has invalid id");
-		}
-
-		const Room& room = self
-			? state.game->playerShip->rooms[id]
-			: state.game->enemyShip->rooms[id];
-
-		if (std::holds_alternative<std::monostate>(state.ui.mouse.aiming))
-		{
-			throw NotSelected("weapon/system");
-		}
-
-		if (std::holds_alternative<SystemUIRef>(state.ui.mouse.aiming))
-		{
-			auto&& system = std::get<SystemUIRef>(state.ui.mouse.aiming).get();
-
-			if (system.type == SystemType::MindControl)
-			{
-				if (!room.mindControllable())
-				{
-					throw InvalidSelfAim("mind control requires a visible room with intruding crew");
-				}
-			}
-			else if (room.player)
-			{
-				throw InvalidSelfAim("only mind control can do that");
-			}
-
-			if (autofire)
-			{
-				throw std::invalid_argument("cannot specify autofire for a system");
-			}
-		}
-
-		bool aimingWeapon = false;
-		if (std::holds_alternative<WeaponUIRef>(state.ui.mouse.aiming))
-		{
-			auto&& weapon = std::get<WeaponUIRef>(state.ui.mouse.aiming).get();
-
-			if (room.player && weapon.blueprint.type != WeaponType::Bomb)
-			{
-				throw InvalidSelfAim("only bomb weapons can do that");
-			}
-
-			aimingWeapon = true;
-		}
+		auto&& room = *roomFor(state, id, self);
+		bool aimingWeapon = std::holds_alternative<WeaponUIRef>(state.ui.mouse.aiming);
 
 		if (aimingWeapon) this->invertAutofire(autofire, false);
 		Input::mouseClick(MouseButton::Left, room.rect.center(), false);
@@ -1662,7 +2578,7 @@ private:
 
 		auto&& weapon = std::get<WeaponUIRef>(state.ui.mouse.aiming).get();
 
-		if (weapon.blueprint.type != WeaponType::Beam)
+		if (weapon.blueprint->type != WeaponType::Beam)
 		{
 			throw NotSelected("beam weapon");
 		}
@@ -1701,14 +2617,14 @@ private:
 	{
 		this->checkInGame("saving crew stations");
 		auto&& state = Reader::getState();
-		this->hotkeyOr("savePositions", state.ui.game->saveStations.center());
+		this->hotkeyOr(Hotkey::SaveStations, state.ui.game->saveStations.center());
 	}
 
 	void loadStations()
 	{
 		this->checkInGame("loading crew stations");
 		auto&& state = Reader::getState();
-		this->hotkeyOr("loadPositions", state.ui.game->loadStations.center());
+		this->hotkeyOr(Hotkey::LoadStations, state.ui.game->loadStations.center());
 	}
 
 	void jump()
@@ -1721,7 +2637,7 @@ private:
 			throw MenuNotAvailable("jump menu", "player can't currently jump");
 		}
 
-		this->hotkeyOr("jump", state.ui.game->ftl.center());
+		this->hotkeyOr(Hotkey::Jump, state.ui.game->ftl.center());
 	}
 
 	void leaveCrew(bool confirm)
@@ -1765,7 +2681,7 @@ private:
 
 		// Otherwise, click button
 		// Default tab will be upgrades
-		this->hotkeyOr("ship_info", state.ui.game->shipButton.center());
+		this->hotkeyOr(Hotkey::ShipInfo, state.ui.game->shipButton.center());
 	}
 
 	void crewManifest()
@@ -1794,7 +2710,7 @@ private:
 		}
 
 		// Try to directly hotkey to it
-		bool direct = this->hotkeyOr("ship_crew", state.ui.game->shipButton.center());
+		bool direct = this->hotkeyOr(Hotkey::ShipCrew, state.ui.game->shipButton.center());
 
 		// Otherwise, re-queue this command to click the tab ones the upgrades menu is open
 		if (!direct)
@@ -1831,7 +2747,7 @@ private:
 		}
 
 		// Try to directly hotkey to it
-		bool direct = this->hotkeyOr("ship_inv", state.ui.game->shipButton.center());
+		bool direct = this->hotkeyOr(Hotkey::ShipCargo, state.ui.game->shipButton.center());
 
 		// Otherwise, re-queue this command to click the tab ones the upgrades menu is open
 		if (!direct)
@@ -1860,7 +2776,7 @@ private:
 		if (state.game->pause.menu) throw WrongMenu(act);
 		if (!button || !store) throw NoStore();
 
-		this->hotkeyOr("store", button->center());
+		this->hotkeyOr(Hotkey::Store, button->center());
 	}
 
 	void menu()
@@ -1908,7 +2824,7 @@ private:
 			int sum = 0;
 			for (int i = to + 1; i <= desired; i++)
 			{
-				sum += actualSys.blueprint.upgradeCosts[i];
+				sum += actualSys.blueprint->upgradeCosts[i];
 			}
 
 			int scrap = state.game->playerShip->cargo.scrap;
@@ -2194,24 +3110,13 @@ private:
 
 	void discardCargo(const DiscardCommand& cmd)
 	{
-		constexpr char act[] = "discarding cargo";
+		auto&& [which] = cmd;
 
 		auto&& state = Reader::getState();
-		if (!state.game) throw GameNotRunning(act);
+		checkDiscardCargo(state, which, true);
+
 		auto&& cargo = state.ui.game->cargo;
-		if (!cargo) throw WrongMenu(act);
 		auto&& box = cargo->discard;
-		if (!box) throw WrongMenu(act);
-
-		auto&& [which] = cmd;
-		auto&& storage = state.game->playerShip->cargo.storage;
-
-		int storageCount = int(storage.size());
-		if (which < 0) throw InvalidSlotChoice("storage slot", which);
-		if (which >= storageCount) throw InvalidSlotChoice("storage slot", which, storageCount);
-
-		bool empty = std::holds_alternative<std::monostate>(storage[which]);
-		if (empty) throw InvalidSlotChoice("cargo", which);
 
 		Input::mouseDown(MouseButton::Left, cargo->storage[which].center());
 		Input::mouseUp(MouseButton::Left, box->center());
@@ -2343,6 +3248,136 @@ void Input::clear()
 	impl.clear();
 }
 
+void Input::setBudget(int inputs)
+{
+	if (inputs < 1)
+	{
+		throw std::invalid_argument("the input budget must be at least 1");
+	}
+
+	impl.budget = inputs;
+}
+
+int Input::budget()
+{
+	return impl.budget;
+}
+
+void Input::allowFusedClicks(bool allow)
+{
+	impl.fusedClicks = allow;
+}
+
+bool Input::fusedClicksAllowed()
+{
+	return impl.fusedClicks;
+}
+
+void Input::setPriority(CommandPriority priority)
+{
+	impl.priority = priority;
+}
+
+void Input::setTag(const std::string& tag)
+{
+	impl.tag = tag;
+}
+
+bool Input::cancel(Ret id)
+{
+	return impl.cancel([&](const Command& cmd) { return cmd.id == id; }) > 0;
+}
+
+size_t Input::cancelTag(const std::string& tag)
+{
+	return impl.cancel([&](const Command& cmd) { return cmd.tag == tag; });
+}
+
+void Input::setDelay(double seconds)
+{
+	if (seconds < 0.0) throw InvalidTime("delays can't be negative");
+
+	impl.delay = seconds;
+	impl.due = Reader::now() + seconds;
+}
+
+double Input::due()
+{
+	return impl.delay > 0.0 ? impl.due : Reader::now();
+}
+
+size_t Input::delayed()
+{
+	return impl.timers.size();
+}
+
+void Input::setRetries(int retries)
+{
+	if (retries < 0) throw std::invalid_argument("the number of retries can't be negative");
+	impl.retries = retries;
+}
+
+int Input::retries()
+{
+	return impl.retries;
+}
+
+const std::map<std::string, VerificationStats>& Input::verification()
+{
+	return impl.verification;
+}
+
+void Input::resetVerification()
+{
+	impl.verification.clear();
+}
+
+std::map<std::string, CommandLatency> Input::latencyStats()
+{
+	std::map<std::string, CommandLatency> stats;
+
+	for (size_t i = 0; i < impl.latency.size(); i++)
+	{
+		auto&& latency = impl.latency[i];
+		auto started = latency.started.stats();
+		if (started.count == 0) continue;
+
+		stats[commandTypeName(Command::Type(i))] = {
+			.started = started,
+			.finished = latency.finished.stats(),
+			.confirmed = latency.confirmed.stats(),
+			.confirmedFrames = latency.confirmedFrames.stats()
+		};
+	}
+
+	return stats;
+}
+
+void Input::resetLatencyStats()
+{
+	impl.latency = {};
+}
+
+uintmax_t Input::frame()
+{
+	return impl.frame;
+}
+
+std::vector<CommandResult> Input::takeResults()
+{
+	return std::exchange(impl.results, {});
+}
+
+std::optional<CommandResult> Input::result(Ret id)
+{
+	for (size_t i = impl.recent.size(); i-- > 0;)
+	{
+		if (impl.recent[i].id == id) return impl.recent[i];
+	}
+
+	return std::nullopt;
+}
+
 Input::Ret Input::dummy()
 {
 	return {};
@@ -2496,19 +3531,182 @@ const decltype(Settings::hotkeys)& Input::hotkeys()
 	return Reader::getState().settings.hotkeys;
 }
 
+bool Input::canPowerSystem(SystemType system, int set, int which)
+{
+	return Impl::ok(Impl::checkPowerSystem(Reader::getState(), system, set, which));
+}
+
+bool Input::canPowerWeapon(int weapon, bool on)
+{
+	return Impl::ok(Impl::checkPowerWeapon(Reader::getState(), weapon, on));
+}
+
+bool Input::canSelectWeapon(int weapon)
+{
+	return Impl::ok(Impl::checkSelectWeapon(Reader::getState(), weapon));
+}
+
+bool Input::canAimWeapon(int weapon, int room, bool self)
+{
+	return Impl::ok(Impl::checkAimWeapon(Reader::getState(), weapon, room, self));
+}
+
+bool Input::canAim(int room, bool self)
+{
+	return Impl::ok(Impl::checkAim(Reader::getState(), room, self));
+}
+
+bool Input::canSendCrew(int room, bool self)
+{
+	return Impl::ok(Impl::checkSendCrew(Reader::getState(), room, self));
+}
+
+bool Input::canDoor(int door, bool open)
+{
+	return Impl::ok(Impl::checkDoor(Reader::getState(), door, open));
+}
+
+bool Input::canChoice(int which)
+{
+	return Impl::ok(Impl::checkChoice(Reader::getState(), which));
+}
+
+const LegalActions& Input::legalActions()
+{
+	static LegalActions actions;
+	Impl::legalActions(Reader::getState(), actions);
+	return actions;
+}
+
+const char* commandStatusMessage(CommandStatus status)
+{
+	switch (status)
+	{
+	case CommandStatus::Ok: return "ok";
+	case CommandStatus::GameNotRunning: return "the game is not running";
+	case CommandStatus::WrongMenu: return "the wrong menu is open";
+	case CommandStatus::SystemNotInstalled: return "the system is not installed";
+	case CommandStatus::InvalidSlot: return "there is nothing in that slot";
+	case CommandStatus::EmptySlot: return "the slot is empty";
+	case CommandStatus::NotPowered: return "it is not powered";
+	case CommandStatus::InvalidPower: return "the power can't be set to that";
+	case CommandStatus::NotEnoughPower: return "there isn't enough power";
+	case CommandStatus::NotEnoughMissiles: return "there isn't enough missiles";
+	case CommandStatus::ZoltanPowered: return "it is fully powered by zoltan crew";
+	case CommandStatus::InvalidRoom: return "the room doesn't exist";
+	case CommandStatus::InvalidSelfAim: return "that can't be aimed at that room";
+	case CommandStatus::InvalidArgument: return "cannot specify autofire for a system";
+	case CommandStatus::NotSelected: return "nothing suitable is selected";
+	case CommandStatus::WrongShip: return "the crew are on the wrong ship";
+	case CommandStatus::DoorInoperable: return "the door can't be operated";
+	case CommandStatus::NoEvent: return "there is no event";
+	case CommandStatus::InvalidChoice: return "the choice can't be picked";
+	case CommandStatus::InvalidSwap: return "those slots can't be swapped";
+	}
+
+	return "unknown status";
+}
+
+namespace
+{
+
+// Only queues the command if the check passed
+template<typename F>
+Input::TryRet tryPush(CommandStatus status, F&& push)
+{
+	if (status != CommandStatus::Ok) return { status, 0 };
+	return { status, push() };
+}
+
+}
+
+Input::TryRet Input::tryPowerSystem(SystemType system, int set, int which)
+{
+	return tryPush(
+		Impl::checkPowerSystem(Reader::getState(), system, set, which),
+		[&] { return powerSystem(system, set, which); }
+	);
+}
+
+Input::TryRet Input::tryPowerWeapon(int weapon, bool on)
+{
+	return tryPush(
+		Impl::checkPowerWeapon(Reader::getState(), weapon, on),
+		[&] { return powerWeapon(weapon, on); }
+	);
+}
+
+Input::TryRet Input::trySelectWeapon(int weapon)
+{
+	return tryPush(
+		Impl::checkSelectWeapon(Reader::getState(), weapon),
+		[&] { return selectWeapon(weapon); }
+	);
+}
+
+Input::TryRet Input::tryAim(int room, bool self, std::optional<bool> autofire)
+{
+	return tryPush(
+		Impl::checkAim(Reader::getState(), room, self, autofire.has_value()),
+		[&] { return aim(room, self, autofire); }
+	);
+}
+
+Input::TryRet Input::trySendCrew(int room, bool self)
+{
+	return tryPush(
+		Impl::checkSendCrew(Reader::getState(), room, self),
+		[&] { return sendCrew(room, self); }
+	);
+}
+
+Input::TryRet Input::tryDoor(int door, bool open)
+{
+	return tryPush(
+		Impl::checkDoor(Reader::getState(), door, open),
+		[&] { return Input::door(door, open); }
+	);
+}
+
+Input::TryRet Input::tryChoice(int which)
+{
+	return tryPush(
+		Impl::checkChoice(Reader::getState(), which),
+		[&] { return choice(which); }
+	);
+}
+
+Input::TryRet Input::trySwapWeapons(int slotA, int slotB)
+{
+	return tryPush(
+		Impl::checkSwapWeapons(Reader::getState(), slotA, slotB),
+		[&] { return swapWeapons(slotA, slotB); }
+	);
+}
+
+Input::TryRet Input::tryDiscardCargo(int slot)
+{
+	return tryPush(
+		Impl::checkDiscardCargo(Reader::getState(), slot),
+		[&] { return discardCargo(slot); }
+	);
+}
+
 Input::Ret Input::text(char ch)
 {
-	return impl.push({
-		.type = Command::Type::TextInput,
-		.args = ch
-	});
+	return text(std::string(1, ch));
 }
 
 Input::Ret Input::text(const std::string& str)
 {
-	Input::Ret last{};
-	for (auto&& c : str) last = text(c);
-	return last;
+	if (str.empty()) return {};
+
+	return impl.push({
+		.type = Command::Type::TextInput,
+		.args = TextCommand{
+			.text = str
+		}
+	});
 }
 
 Input::Ret Input::textConfirm()
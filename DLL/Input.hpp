@@ -4,6 +4,11 @@
 
 #include <optional>
 #include <functional>
+#include <array>
+#include <utility>
+#include <string>
+#include <vector>
+#include <map>
 
 // Very hacky way of signalling to Windows this is generated by the AI
 // ... if the Windows API is needed anyways
@@ -21,6 +26,97 @@ enum class InputDirection
 	Up = 0, Down = 1
 };
 
+// Why a command would or wouldn't be accepted
+enum class CommandStatus
+{
+	Ok,
+	GameNotRunning,
+	WrongMenu,
+	SystemNotInstalled,
+	InvalidSlot,
+	EmptySlot,
+	NotPowered,
+	InvalidPower,
+	NotEnoughPower,
+	NotEnoughMissiles,
+	ZoltanPowered,
+	InvalidRoom,
+	InvalidSelfAim,
+	InvalidArgument,
+	NotSelected,
+	WrongShip,
+	DoorInoperable,
+	NoEvent,
+	InvalidChoice,
+	InvalidSwap
+};
+
+const char* commandStatusMessage(CommandStatus status);
+
+// Urgent commands go before normal ones, but don't interrupt a command that's partway through
+enum class CommandPriority
+{
+	Normal,
+	Urgent
+};
+
+// What happened to a queued command once it finished
+// Commands that queue other commands finish once all of those have finished
+struct CommandResult
+{
+	uintmax_t id = 0;
+	uintmax_t frame = 0; // see Input::frame()
+	double time = 0.0; // see Reader::now()
+	std::string error; // empty if it succeeded
+};
+
+// How often a kind of command had the effect it was meant to on the state
+// Only some commands check this: powering systems and weapons, doors and selecting crew
+struct VerificationStats
+{
+	uintmax_t verified = 0; // had the effect, possibly after retrying
+	uintmax_t failed = 0; // didn't, even after retrying, or raised an exception
+	uintmax_t retries = 0;
+	double latency = 0.0; // total seconds from first running to having the effect, for the verified ones
+	uintmax_t latencyFrames = 0; // same as above, in frames
+};
+
+// Percentiles of some latency, over the last Input::LATENCY_SAMPLES commands of a kind
+struct LatencyStats
+{
+	size_t count = 0;
+	double p50 = 0.0, p95 = 0.0, p99 = 0.0, max = 0.0;
+};
+
+// All times are from when the command was queued, or when it was due if it had a delay
+struct CommandLatency
+{
+	LatencyStats started; // seconds until it started running
+	LatencyStats finished; // seconds until it and any commands it queued finished
+	LatencyStats confirmed; // seconds until its effect was seen in the state, see VerificationStats
+	LatencyStats confirmedFrames; // frames from first running until its effect was seen in the state
+};
+
+// Which actions would currently be accepted, for every action up to some maximums
+// Anything past the end of a list is false
+struct LegalActions
+{
+	static constexpr size_t SYSTEMS = size_t(SystemType::Hacking) + 1;
+	static constexpr int MAX_POWER = 8;
+	static constexpr int MAX_WEAPONS = 4;
+	static constexpr int MAX_ROOMS = 32;
+	static constexpr int MAX_DOORS = 64;
+	static constexpr int MAX_CHOICES = 10;
+
+	// Ship indices are 0 for the player ship and 1 for the enemy ship
+	std::array<std::array<bool, MAX_POWER + 1>, SYSTEMS> power{}; // [system type][power level]
+	std::array<std::array<bool, 2>, MAX_WEAPONS> weaponPower{}; // [weapon][off/on]
+	std::array<std::array<std::array<bool, MAX_ROOMS>, 2>, MAX_WEAPONS> aimWeapon{}; // [weapon][ship][room]
+	std::array<std::array<bool, MAX_ROOMS>, 2> sendCrew{}; // [ship][room]
+	std::array<std::array<bool, 2>, MAX_DOORS> door{}; // [door][close/open]
+	std::array<bool, MAX_CHOICES> choice{}; // [choice]
+};
+
 class Input
 {
 	class Impl;
@@ -40,6 +136,44 @@ public:
 	static bool humanMouseAllowed(); // checks if human mouse input is allowed
 	static bool humanKeyboardAllowed(); // checks if human keyboard input is allowed
 	static void clear(); // clears the input queue
+	static void setBudget(int inputs); // sets the most raw inputs made per frame
+	static int budget(); // gets the most raw inputs made per frame
+	static void allowFusedClicks(bool allow = true); // sets if clicks can be in the same frame as moving the mouse
+	static bool fusedClicksAllowed(); // checks if clicks can be in the same frame as moving the mouse
+
+	// Commands queued while a delay is set are held back until that many seconds after it was set
+	// They don't hold up the rest of the queue, and aren't counted by empty()
+	// Set it back to 0 to stop delaying commands
+	static void setDelay(double seconds);
+	static double due(); // the earliest time commands queued now will be executed
+	static size_t delayed(); // how many delayed commands are waiting to be due
+
+	// Commands queued while these are set get that priority and tag
+	// Set them back to Normal and "" when done
+	static void setPriority(CommandPriority priority);
+	static void setTag(const std::string& tag);
+
+	// Removes commands that haven't started yet, returning if/how many were removed
+	static bool cancel(uintmax_t id);
+	static size_t cancelTag(const std::string& tag);
+
+	// Results of commands, including ones that failed or were cleared
+	static constexpr size_t RESULTS_KEPT = 1024;
+	static uintmax_t frame(); // how many times inputs have been made
+	static std::vector<CommandResult> takeResults(); // every result since this was last called
+	static std::optional<CommandResult> result(uintmax_t id); // looks up one of the last RESULTS_KEPT results
+
+	// Some commands are checked on the next few frames to see if the state changed like it should have
+	// If not (e.g. a click got eaten), they're queued again up to this many times
+	static void setRetries(int retries);
+	static int retries();
+	static const std::map<std::string, VerificationStats>& verification(); // by command name, e.g. "power_system"
+	static void resetVerification();
+
+	// Latencies for every kind of command that has finished, by name, e.g. "aim" or "mouse"
+	static constexpr size_t LATENCY_SAMPLES = 256;
+	static std::map<std::string, CommandLatency> latencyStats();
+	static void resetLatencyStats();
 
 	// All inputs below are added to a queue, not done immediately
 	// This is so they're roughly executed sequentially
@@ -79,6 +213,33 @@ public:
 	using Hotkeys = decltype(Settings::hotkeys);
 	static const Hotkeys& hotkeys();
 
+	// Checks if a command would be accepted right now, without doing anything
+	static bool canPowerSystem(SystemType system, int set, int which = 0);
+	static bool canPowerWeapon(int weapon, bool on = true);
+	static bool canSelectWeapon(int weapon);
+	static bool canAimWeapon(int weapon, int room, bool self = false); // select, then aim
+	static bool canAim(int room, bool self = false); // aim what's already selected
+	static bool canSendCrew(int room, bool self = true);
+	static bool canDoor(int door, bool open);
+	static bool canChoice(int which);
+
+	// Computes all of the above (where applicable) for the current state
+	static const LegalActions& legalActions();
+
+	// Checks the command first, and only queues it if it would be accepted
+	// The id is 0 if it wasn't queued
+	using TryRet = std::pair<CommandStatus, Ret>;
+
+	static TryRet tryPowerSystem(SystemType system, int set = 0, int which = 0);
+	static TryRet tryPowerWeapon(int weapon, bool on = true);
+	static TryRet trySelectWeapon(int weapon);
+	static TryRet tryAim(int room, bool self = false, std::optional<bool> autofire = std::nullopt);
+	static TryRet trySendCrew(int room, bool self = true);
+	static TryRet tryDoor(int door, bool open);
+	static TryRet tryChoice(int which);
+	static TryRet trySwapWeapons(int slotA, int slotB);
+	static TryRet tryDiscardCargo(int slot);
+
 	static Ret text(char ch);
 	static Ret text(const std::string& str);
 	static Ret textConfirm();
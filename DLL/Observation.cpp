@@ -0,0 +1,291 @@
+#include "Observation.hpp"
+
+#include <unordered_map>
+#include <stdexcept>
+#include <algorithm>
+
+namespace
+{
+
+constexpr size_t SYSTEM_TYPES = size_t(SystemType::Hacking) + 1;
+
+template<typename T>
+using FieldTable = std::unordered_map<std::string, float(*)(const T&)>;
+
+float f(bool b) { return b ? 1.f : 0.f; }
+
+const FieldTable<Ship>& shipFieldTable()
+{
+	static const FieldTable<Ship> table{
+		{"present", [](const Ship&) { return 1.f; }},
+		{"hull", [](const Ship& s) { return float(s.hull.first); }},
+		{"hull_max", [](const Ship& s) { return float(s.hull.second); }},
+		{"super_shields", [](const Ship& s) { return float(s.superShields.first); }},
+		{"super_shields_max", [](const Ship& s) { return float(s.superShields.second); }},
+		{"evasion", [](const Ship& s) { return float(s.evasion); }},
+		{"total_oxygen", [](const Ship& s) { return s.totalOxygen; }},
+		{"reactor", [](const Ship& s) { return float(s.reactor.total.first); }},
+		{"reactor_max", [](const Ship& s) { return float(s.reactor.total.second); }},
+		{"jump_timer", [](const Ship& s) { return s.jumpTimer.first; }},
+		{"jump_timer_max", [](const Ship& s) { return s.jumpTimer.second; }},
+		{"jumping", [](const Ship& s) { return f(s.jumping); }},
+		{"can_jump", [](const Ship& s) { return f(s.canJump); }},
+		{"destroyed", [](const Ship& s) { return f(s.destroyed); }},
+		{"automated", [](const Ship& s) { return f(s.automated); }},
+	};
+
+	return table;
+}
+
+const FieldTable<System>& systemFieldTable()
+{
+	static const FieldTable<System> table{
+		{"present", [](const System&) { return 1.f; }},
+		{"power", [](const System& s) { return float(s.power.total.first); }},
+		{"power_max", [](const System& s) { return float(s.power.total.second); }},
+		{"power_required", [](const System& s) { return float(s.power.required); }},
+		{"ion_level", [](const System& s) { return float(s.power.ionLevel); }},
+		{"health", [](const System& s) { return float(s.health.first); }},
+		{"health_max", [](const System& s) { return float(s.health.second); }},
+		{"level", [](const System& s) { return float(s.level.first); }},
+		{"level_max", [](const System& s) { return float(s.level.second); }},
+		{"manning_level", [](const System& s) { return float(s.manningLevel); }},
+		{"hack_level", [](const System& s) { return float(s.hackLevel); }},
+		{"occupied", [](const System& s) { return f(s.occupied); }},
+		{"on_fire", [](const System& s) { return f(s.onFire); }},
+		{"breached", [](const System& s) { return f(s.breached); }},
+		{"damage_progress", [](const System& s) { return s.damageProgress; }},
+		{"repair_progress", [](const System& s) { return s.repairProgress; }},
+	};
+
+	return table;
+}
+
+const FieldTable<Room>& roomFieldTable()
+{
+	static const FieldTable<Room> table{
+		{"present", [](const Room&) { return 1.f; }},
+		{"id", [](const Room& r) { return float(r.id); }},
+		{"system", [](const Room& r) { return float(r.system); }},
+		{"x", [](const Room& r) { return float(r.rect.x); }},
+		{"y", [](const Room& r) { return float(r.rect.y); }},
+		{"w", [](const Room& r) { return float(r.rect.w); }},
+		{"h", [](const Room& r) { return float(r.rect.h); }},
+		{"oxygen", [](const Room& r) { return r.oxygen; }},
+		{"visible", [](const Room& r) { return f(r.visible); }},
+		{"stunning", [](const Room& r) { return f(r.stunning); }},
+		{"hack_level", [](const Room& r) { return float(r.hackLevel); }},
+		{"crew", [](const Room& r) { return float(r.crew.size()); }},
+		{"intruders", [](const Room& r) { return float(r.intruders.size()); }},
+		{"fire_repair", [](const Room& r) { return r.fireRepair; }},
+		{"breach_repair", [](const Room& r) { return r.breachRepair; }},
+		{"slots_occupiable", [](const Room& r) { return float(r.slotsOccupiable); }},
+	};
+
+	return table;
+}
+
+const FieldTable<Crew>& crewFieldTable()
+{
+	static const FieldTable<Crew> table{
+		{"present", [](const Crew&) { return 1.f; }},
+		{"id", [](const Crew& c) { return float(c.id); }},
+		{"room", [](const Crew& c) { return float(c.room); }},
+		{"slot", [](const Crew& c) { return float(c.slot); }},
+		{"x", [](const Crew& c) { return c.position.x; }},
+		{"y", [](const Crew& c) { return c.position.y; }},
+		{"goal_x", [](const Crew& c) { return c.goal.x; }},
+		{"goal_y", [](const Crew& c) { return c.goal.y; }},
+		{"health", [](const Crew& c) { return c.health.first; }},
+		{"health_max", [](const Crew& c) { return c.health.second; }},
+		{"player", [](const Crew& c) { return f(c.player); }},
+		{"on_player_ship", [](const Crew& c) { return f(c.onPlayerShip); }},
+		{"intruder", [](const Crew& c) { return f(c.intruder); }},
+		{"moving", [](const Crew& c) { return f(c.moving); }},
+		{"fighting", [](const Crew& c) { return f(c.fighting); }},
+		{"repairing", [](const Crew& c) { return f(c.repairing); }},
+		{"manning", [](const Crew& c) { return f(c.manning); }},
+		{"manned_system", [](const Crew& c) { return float(c.mannedSystem); }},
+		{"suffocating", [](const Crew& c) { return f(c.suffocating); }},
+		{"on_fire", [](const Crew& c) { return float(c.onFire); }},
+		{"dead", [](const Crew& c) { return f(c.dead); }},
+		{"mind_controlled", [](const Crew& c) { return f(c.mindControlled); }},
+		{"drone", [](const Crew& c) { return f(c.drone); }},
+	};
+
+	return table;
+}
+
+const FieldTable<Projectile>& projectileFieldTable()
+{
+	static const FieldTable<Projectile> table{
+		{"present", [](const Projectile&) { return 1.f; }},
+		{"type", [](const Projectile& p) { return float(p.type); }},
+		{"x", [](const Projectile& p) { return p.position.x; }},
+		{"y", [](const Projectile& p) { return p.position.y; }},
+		{"target_x", [](const Projectile& p) { return p.target.x; }},
+		{"target_y", [](const Projectile& p) { return p.target.y; }},
+		{"speed_x", [](const Projectile& p) { return p.speed.x; }},
+		{"speed_y", [](const Projectile& p) { return p.speed.y; }},
+		{"heading", [](const Projectile& p) { return p.heading; }},
+		{"lifespan", [](const Projectile& p) { return p.lifespan; }},
+		{"player", [](const Projectile& p) { return f(p.player); }},
+		{"player_space", [](const Projectile& p) { return f(p.playerSpace); }},
+		{"player_space_is_destination", [](const Projectile& p) { return f(p.playerSpaceIsDestination); }},
+		{"dying", [](const Projectile& p) { return f(p.dying); }},
+		{"missed", [](const Projectile& p) { return f(p.missed); }},
+		{"hit", [](const Projectile& p) { return f(p.hit); }},
+	};
+
+	return table;
+}
+
+template<typename T>
+std::vector<float(*)(const T&)> lookupFields(
+	const FieldTable<T>& table,
+	const std::vector<std::string>& names,
+	const char* what)
+{
+	std::vector<float(*)(const T&)> fields;
+
+	for (auto&& name : names)
+	{
+		auto it = table.find(name);
+
+		if (it == table.end())
+		{
+			throw std::invalid_argument(
+				"there is no " + std::string(what) + " field called '" + name + "'"
+			);
+		}
+
+		fields.push_back(it->second);
+	}
+
+	return fields;
+}
+
+void checkMax(int max, const char* what)
+{
+	if (max < 0)
+	{
+		throw std::invalid_argument(
+			"the maximum number of " + std::string(what) + " can't be negative"
+		);
+	}
+}
+
+}
+
+ObservationEncoder::ObservationEncoder(const ObservationSchema& schema)
+	: config(schema)
+	, shipFields(lookupFields(shipFieldTable(), schema.ship, "ship"))
+	, systemFields(lookupFields(systemFieldTable(), schema.systems, "system"))
+	, roomFields(lookupFields(roomFieldTable(), schema.rooms, "room"))
+	, crewFields(lookupFields(crewFieldTable(), schema.crew, "crew"))
+	, projectileFields(lookupFields(projectileFieldTable(), schema.projectiles, "projectile"))
+{
+	checkMax(schema.maxRooms, "rooms");
+	checkMax(schema.maxCrew, "crew");
+	checkMax(schema.maxProjectiles, "projectiles");
+
+	size_t perShip =
+		this->shipFields.size() +
+		this->systemFields.size() * SYSTEM_TYPES +
+		this->roomFields.size() * size_t(schema.maxRooms);
+
+	size_t total =
+		perShip * 2 +
+		this->crewFields.size() * size_t(schema.maxCrew) * 2 +
+		this->projectileFields.size() * size_t(schema.maxProjectiles);
+
+	this->tensor.assign(total, schema.padding);
+}
+
+template<typename T>
+void ObservationEncoder::encodeOne(float*& out, const Fields<T>& fields, const T* obj) const
+{
+	if (!obj)
+	{
+		out = std::fill_n(out, fields.size(), this->config.padding);
+		return;
+	}
+
+	for (auto&& field : fields)
+	{
+		*out++ = field(*obj);
+	}
+}
+
+template<typename T>
+void ObservationEncoder::encodeList(float*& out, const Fields<T>& fields, const std::vector<T>& list, int max) const
+{
+	for (size_t i = 0; i < size_t(max); i++)
+	{
+		this->encodeOne(out, fields, i < list.size() ? &list[i] : nullptr);
+	}
+}
+
+void ObservationEncoder::encodeShip(float*& out, const std::optional<Ship>& ship) const
+{
+	static const std::vector<Room> noRooms;
+
+	this->encodeOne(out, this->shipFields, ship ? &*ship : nullptr);
+
+	for (size_t i = 0; i < SYSTEM_TYPES; i++)
+	{
+		auto type = SystemType(i);
+		const System* system = ship && ship->hasSystem(type) ? &ship->getSystem(type) : nullptr;
+		this->encodeOne(out, this->systemFields, system);
+	}
+
+	this->encodeList(out, this->roomFields, ship ? ship->rooms : noRooms, this->config.maxRooms);
+}
+
+void ObservationEncoder::encode(const State& state)
+{
+	static const std::optional<Ship> noShip;
+	static const std::vector<Crew> noCrew;
+	static const std::vector<Projectile> noProjectiles;
+
+	float* out = this->tensor.data();
+	auto&& game = state.game;
+
+	this->encodeShip(out, game ? game->playerShip : noShip);
+	this->encodeShip(out, game ? game->enemyShip : noShip);
+	this->encodeList(out, this->crewFields, game ? game->playerCrew : noCrew, this->config.maxCrew);
+	this->encodeList(out, this->crewFields, game ? game->enemyCrew : noCrew, this->config.maxCrew);
+	this->encodeList(out, this->projectileFields, game ? game->space.projectiles : noProjectiles, this->config.maxProjectiles);
+}
+
+std::vector<std::string> ObservationEncoder::labels() const
+{
+	std::vector<std::string> labels;
+	labels.reserve(this->tensor.size());
+
+	auto add = [&](const std::string& prefix, const std::vector<std::string>& fields) {
+		for (auto&& field : fields) labels.push_back(prefix + "." + field);
+	};
+
+	auto addList = [&](const std::string& prefix, const std::vector<std::string>& fields, int max) {
+		for (int i = 0; i < max; i++) add(prefix + "[" + std::to_string(i) + "]", fields);
+	};
+
+	for (auto&& ship : { "player_ship", "enemy_ship" })
+	{
+		add(ship, this->config.ship);
+
+		for (size_t i = 0; i < SYSTEM_TYPES; i++)
+		{
+			add(std::string(ship) + ".systems[" + systemName(SystemType(i)) + "]", this->config.systems);
+		}
+
+		addList(std::string(ship) + ".rooms", this->config.rooms, this->config.maxRooms);
+	}
+
+	addList("player_crew", this->config.crew, this->config.maxCrew);
+	addList("enemy_crew", this->config.crew, this->config.maxCrew);
+	addList("projectiles", this->config.projectiles, this->config.maxProjectiles);
+
+	return labels;
+}
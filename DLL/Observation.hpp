@@ -0,0 +1,68 @@
+#pragma once
+
+#include "State.hpp"
+
+#include <string>
+#include <vector>
+
+// Which fields go into an observation, and how many of each thing there's room for
+// Field names are the same as the Python attribute names, e.g. "hull" or "oxygen"
+struct ObservationSchema
+{
+	std::vector<std::string> ship; // for the player ship, then the enemy ship
+	std::vector<std::string> systems; // for every system type on each ship, in SystemType order
+	std::vector<std::string> rooms; // for each ship
+	std::vector<std::string> crew; // for the player crew, then the enemy crew
+	std::vector<std::string> projectiles;
+
+	int maxRooms = 0, maxCrew = 0, maxProjectiles = 0;
+
+	float padding = 0.f; // used for things that aren't there
+};
+
+// Turns the state into a flat array of floats with the same layout every time
+// The layout is:
+//   player ship, player systems, player rooms,
+//   enemy ship, enemy systems, enemy rooms,
+//   player crew, enemy crew, projectiles
+class ObservationEncoder
+{
+public:
+	// Throws std::invalid_argument if a field doesn't exist
+	explicit ObservationEncoder(const ObservationSchema& schema);
+
+	// Overwrites the tensor with the given state
+	void encode(const State& state);
+
+	const ObservationSchema& schema() const { return this->config; }
+	const float* data() const { return this->tensor.data(); }
+	size_t size() const { return this->tensor.size(); }
+
+	// Names of every value in the tensor, e.g. "enemy_ship.rooms[3].oxygen"
+	std::vector<std::string> labels() const;
+
+private:
+	template<typename T>
+	using Field = float(*)(const T&);
+
+	template<typename T>
+	using Fields = std::vector<Field<T>>;
+
+	void encodeShip(float*& out, const std::optional<Ship>& ship) const;
+
+	template<typename T>
+	void encodeList(float*& out, const Fields<T>& fields, const std::vector<T>& list, int max) const;
+
+	template<typename T>
+	void encodeOne(float*& out, const Fields<T>& fields, const T* obj) const;
+
+	ObservationSchema config;
+
+	Fields<Ship> shipFields;
+	Fields<System> systemFields;
+	Fields<Room> roomFields;
+	Fields<Crew> crewFields;
+	Fields<Projectile> projectileFields;
+
+	std::vector<float> tensor;
+};
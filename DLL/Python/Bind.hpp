@@ -13,3 +13,128 @@
 namespace py = pybind11;
 
 #pragma warning(pop) 
+
+#include "../State.hpp"
+
+#include <string>
+#include <map>
+#include <vector>
+
+// These are bound as views of the state instead of being converted to lists/dicts
+// Otherwise every access to something like ship.rooms would copy every room
+using BlueprintMapWeapons = std::map<std::string, WeaponBlueprint>;
+using BlueprintMapDrones = std::map<std::string, DroneBlueprint>;
+using BlueprintMapCrew = std::map<std::string, CrewBlueprint>;
+using BlueprintMapSystems = std::map<std::string, SystemBlueprint>;
+using BlueprintMapAugments = std::map<std::string, Augment>;
+
+PYBIND11_MAKE_OPAQUE(std::vector<Rect<int>>)
+PYBIND11_MAKE_OPAQUE(std::vector<Slot>)
+PYBIND11_MAKE_OPAQUE(std::vector<Room>)
+PYBIND11_MAKE_OPAQUE(std::vector<Door>)
+PYBIND11_MAKE_OPAQUE(std::vector<Crew>)
+PYBIND11_MAKE_OPAQUE(std::vector<Weapon>)
+PYBIND11_MAKE_OPAQUE(std::vector<Drone>)
+PYBIND11_MAKE_OPAQUE(std::vector<Projectile>)
+PYBIND11_MAKE_OPAQUE(std::vector<ArtillerySystem>)
+PYBIND11_MAKE_OPAQUE(std::vector<CargoItem>)
+PYBIND11_MAKE_OPAQUE(std::vector<Augment>)
+PYBIND11_MAKE_OPAQUE(std::vector<EventDamage>)
+PYBIND11_MAKE_OPAQUE(std::vector<Choice>)
+PYBIND11_MAKE_OPAQUE(std::vector<StoreBox>)
+PYBIND11_MAKE_OPAQUE(std::vector<Location>)
+PYBIND11_MAKE_OPAQUE(std::vector<Sector>)
+PYBIND11_MAKE_OPAQUE(BlueprintMapWeapons)
+PYBIND11_MAKE_OPAQUE(BlueprintMapDrones)
+PYBIND11_MAKE_OPAQUE(BlueprintMapCrew)
+PYBIND11_MAKE_OPAQUE(BlueprintMapSystems)
+PYBIND11_MAKE_OPAQUE(BlueprintMapAugments)
+
+namespace python_bindings
+{
+
+// Resolves futures for finished commands and runs the asyncio event loop for a bit
+// Call with the GIL held, once per frame
+void runEventLoop();
+
+// Binds a read-only list that references the vector it came from
+// Elements keep the vector (and so the state) alive while they're in use
+template<typename Vector>
+void bindVectorView(py::handle scope, const char* name, const char* doc)
+{
+	py::class_<Vector>(scope, name, doc)
+		.def("__len__", [](const Vector& v) { return v.size(); })
+		.def("__bool__", [](const Vector& v) { return !v.empty(); })
+		.def("__getitem__", [](const Vector& v, py::ssize_t i) -> const typename Vector::value_type& {
+			if (i < 0) i += py::ssize_t(v.size());
+			if (i < 0 || size_t(i) >= v.size()) throw py::index_error();
+			return v[size_t(i)];
+		}, py::return_value_policy::reference_internal)
+		.def("__getitem__", [](py::object self, const py::slice& slice) {
+			auto&& v = self.cast<const Vector&>();
+			size_t start = 0, stop = 0, step = 0, length = 0;
+			if (!slice.compute(v.size(), &start, &stop, &step, &length)) throw py::error_already_set();
+
+			py::list list;
+
+			for (size_t i = 0; i < length; i++, start += step)
+			{
+				list.append(py::cast(v[start], py::return_value_policy::reference_internal, self));
+			}
+
+			return list;
+		})
+		.def("__iter__", [](const Vector& v) {
+			return py::make_iterator<py::return_value_policy::reference_internal>(v.begin(), v.end());
+		}, py::keep_alive<0, 1>())
+		;
+}
+
+// Binds a read-only dictionary that references the map it came from
+// Only used for maps with string keys
+template<typename Map>
+void bindMapView(py::handle scope, const char* name, const char* doc)
+{
+	using Key = typename Map::key_type;
+	using Value = typename Map::mapped_type;
+
+	py::class_<Map>(scope, name, doc)
+		.def("__len__", [](const Map& m) { return m.size(); })
+		.def("__bool__", [](const Map& m) { return !m.empty(); })
+		.def("__contains__", [](const Map& m, const Key& k) { return m.contains(k); })
+		.def("__getitem__", [](const Map& m, const Key& k) -> const Value& {
+			auto it = m.find(k);
+			if (it == m.end()) throw py::key_error(k);
+			return it->second;
+		}, py::return_value_policy::reference_internal)
+		.def("get", [](py::object self, const Key& k, py::object fallback) -> py::object {
+			auto&& m = self.cast<const Map&>();
+			auto it = m.find(k);
+			if (it == m.end()) return fallback;
+			return py::cast(it->second, py::return_value_policy::reference_internal, self);
+		}, py::arg("key"), py::arg("default") = py::none())
+		.def("__iter__", [](const Map& m) {
+			return py::make_key_iterator(m.begin(), m.end());
+		}, py::keep_alive<0, 1>())
+		.def("keys", [](const Map& m) {
+			return py::make_key_iterator(m.begin(), m.end());
+		}, py::keep_alive<0, 1>())
+		.def("values", [](py::object self) {
+			auto&& m = self.cast<const Map&>();
+			py::list list;
+
+			for (auto&& [k, v] : m)
+			{
+				list.append(py::cast(v, py::return_value_policy::reference_internal, self));
+			}
+
+			return list;
+		})
+		.def("items", [](const Map& m) {
+			return py::make_iterator<py::return_value_policy::reference_internal>(m.begin(), m.end());
+		}, py::keep_alive<0, 1>())
+		;
+}
+
+}
+
@@ -0,0 +1,228 @@
+#include "Bind.hpp"
+#include "../State.hpp"
+
+#include <pybind11/numpy.h>
+
+namespace python_bindings
+{
+
+namespace
+{
+
+// One row per object, only numbers so NumPy can use them directly
+
+struct CrewRecord
+{
+	int32_t id, room, slot, mannedSystem;
+	float x, y, goalX, goalY;
+	float health, healthMax;
+	bool player, onPlayerShip, intruder, moving, fighting, repairing, manning, dead, mindControlled, drone;
+};
+
+struct ProjectileRecord
+{
+	int32_t type;
+	float x, y, targetX, targetY, speedX, speedY;
+	float heading, lifespan;
+	bool player, playerSpace, playerSpaceIsDestination, dying, missed, hit;
+};
+
+struct RoomRecord
+{
+	int32_t id, system, x, y, w, h;
+	int32_t hackLevel, crew, intruders, slotsOccupiable;
+	float oxygen, fireRepair, breachRepair;
+	bool player, visible, stunning;
+};
+
+struct WeaponRecord
+{
+	int32_t slot, power, powerRequired, charge, chargeMax, hackLevel, mountX, mountY;
+	float cooldown, cooldownMax;
+	bool powered, autofire, artillery, targetingPlayer;
+};
+
+void fill(CrewRecord& out, const Crew& crew)
+{
+	out.id = crew.id;
+	out.room = crew.room;
+	out.slot = crew.slot;
+	out.mannedSystem = int32_t(crew.mannedSystem);
+	out.x = crew.position.x;
+	out.y = crew.position.y;
+	out.goalX = crew.goal.x;
+	out.goalY = crew.goal.y;
+	out.health = crew.health.first;
+	out.healthMax = crew.health.second;
+	out.player = crew.player;
+	out.onPlayerShip = crew.onPlayerShip;
+	out.intruder = crew.intruder;
+	out.moving = crew.moving;
+	out.fighting = crew.fighting;
+	out.repairing = crew.repairing;
+	out.manning = crew.manning;
+	out.dead = crew.dead;
+	out.mindControlled = crew.mindControlled;
+	out.drone = crew.drone;
+}
+
+void fill(ProjectileRecord& out, const Projectile& projectile)
+{
+	out.type = int32_t(projectile.type);
+	out.x = projectile.position.x;
+	out.y = projectile.position.y;
+	out.targetX = projectile.target.x;
+	out.targetY = projectile.target.y;
+	out.speedX = projectile.speed.x;
+	out.speedY = projectile.speed.y;
+	out.heading = projectile.heading;
+	out.lifespan = projectile.lifespan;
+	out.player = projectile.player;
+	out.playerSpace = projectile.playerSpace;
+	out.playerSpaceIsDestination = projectile.playerSpaceIsDestination;
+	out.dying = projectile.dying;
+	out.missed = projectile.missed;
+	out.hit = projectile.hit;
+}
+
+void fill(RoomRecord& out, const Room& room)
+{
+	out.id = room.id;
+	out.system = int32_t(room.system);
+	out.x = room.rect.x;
+	out.y = room.rect.y;
+	out.w = room.rect.w;
+	out.h = room.rect.h;
+	out.hackLevel = int32_t(room.hackLevel);
+	out.crew = int32_t(room.crew.size());
+	out.intruders = int32_t(room.intruders.size());
+	out.slotsOccupiable = room.slotsOccupiable;
+	out.oxygen = room.oxygen;
+	out.fireRepair = room.fireRepair;
+	out.breachRepair = room.breachRepair;
+	out.player = room.player;
+	out.visible = room.visible;
+	out.stunning = room.stunning;
+}
+
+void fill(WeaponRecord& out, const Weapon& weapon)
+{
+	out.slot = weapon.slot;
+	out.power = weapon.power.total.first;
+	out.powerRequired = weapon.power.required;
+	out.charge = weapon.charge.first;
+	out.chargeMax = weapon.charge.second;
+	out.hackLevel = int32_t(weapon.hackLevel);
+	out.mountX = weapon.mount.x;
+	out.mountY = weapon.mount.y;
+	out.cooldown = weapon.cooldown.first;
+	out.cooldownMax = weapon.cooldown.second;
+	out.powered = weapon.powered();
+	out.autofire = weapon.autofire;
+	out.artillery = weapon.artillery;
+	out.targetingPlayer = weapon.targetingPlayer;
+}
+
+// NumPy is only needed once these are used, so the module still loads without it
+void registerDtypes()
+{
+	static bool registered = false;
+	if (registered) return;
+
+	PYBIND11_NUMPY_DTYPE_EX(CrewRecord,
+		id, "id", room, "room", slot, "slot", mannedSystem, "manned_system",
+		x, "x", y, "y", goalX, "goal_x", goalY, "goal_y",
+		health, "health", healthMax, "health_max",
+		player, "player", onPlayerShip, "on_player_ship", intruder, "intruder",
+		moving, "moving", fighting, "fighting", repairing, "repairing", manning, "manning",
+		dead, "dead", mindControlled, "mind_controlled", drone, "drone"
+	);
+
+	PYBIND11_NUMPY_DTYPE_EX(ProjectileRecord,
+		type, "type",
+		x, "x", y, "y", targetX, "target_x", targetY, "target_y", speedX, "speed_x", speedY, "speed_y",
+		heading, "heading", lifespan, "lifespan",
+		player, "player", playerSpace, "player_space", playerSpaceIsDestination, "player_space_is_destination",
+		dying, "dying", missed, "missed", hit, "hit"
+	);
+
+	PYBIND11_NUMPY_DTYPE_EX(RoomRecord,
+		id, "id", system, "system", x, "x", y, "y", w, "w", h, "h",
+		hackLevel, "hack_level", crew, "crew", intruders, "intruders", slotsOccupiable, "slots_occupiable",
+		oxygen, "oxygen", fireRepair, "fire_repair", breachRepair, "breach_repair",
+		player, "player", visible, "visible", stunning, "stunning"
+	);
+
+	PYBIND11_NUMPY_DTYPE_EX(WeaponRecord,
+		slot, "slot", power, "power", powerRequired, "power_required",
+		charge, "charge", chargeMax, "charge_max", hackLevel, "hack_level",
+		mountX, "mount_x", mountY, "mount_y",
+		cooldown, "cooldown", cooldownMax, "cooldown_max",
+		powered, "powered", autofire, "autofire", artillery, "artillery", targetingPlayer, "targeting_player"
+	);
+
+	registered = true;
+}
+
+// Fills a new array in one go, no Python objects are made per element
+template<typename Record, typename T>
+py::array_t<Record> toArray(const std::vector<T>& list)
+{
+	registerDtypes();
+
+	py::array_t<Record> array(py::ssize_t(list.size()));
+	Record* out = array.mutable_data();
+
+	for (size_t i = 0; i < list.size(); i++)
+	{
+		fill(out[i], list[i]);
+	}
+
+	return array;
+}
+
+}
+
+void bindArrays(py::module_& module)
+{
+	auto&& sub = module.def_submodule(
+		"arrays",
+		"Submodule for getting parts of the state as NumPy structured arrays\n\n"
+		"Each function takes a list from the state and returns an array with one row per element.\n"
+		"The arrays are copies, so get them again each frame."
+	);
+
+	sub.def(
+		"crew",
+		&toArray<CrewRecord, Crew>,
+		py::arg("crew"),
+		"Gets an array of crew, e.g. ftl.arrays.crew(ftl.state().game.player_crew)\n"
+		"Enums (manned_system) are stored as their integer values"
+	);
+
+	sub.def(
+		"projectiles",
+		&toArray<ProjectileRecord, Projectile>,
+		py::arg("projectiles"),
+		"Gets an array of projectiles, e.g. ftl.arrays.projectiles(ftl.state().game.space.projectiles)\n"
+		"Enums (type) are stored as their integer values"
+	);
+
+	sub.def(
+		"rooms",
+		&toArray<RoomRecord, Room>,
+		py::arg("rooms"),
+		"Gets an array of rooms, e.g. ftl.arrays.rooms(ftl.state().game.player_ship.rooms)\n"
+		"Enums (system, hack_level) are stored as their integer values; crew and intruders are counts"
+	);
+
+	sub.def(
+		"weapons",
+		&toArray<WeaponRecord, Weapon>,
+		py::arg("weapons"),
+		"Gets an array of weapons, e.g. ftl.arrays.weapons(ftl.state().game.player_ship.weapons.list)\n"
+		"Enums (hack_level) are stored as their integer values"
+	);
+}
+
+}
@@ -70,6 +70,13 @@ void bindBlueprints(py::module_& module)
 		.def_readonly("crew", &Blueprints::crewBlueprints, "Crew blueprint dictionary")
 		.def_readonly("systems", &Blueprints::systemBlueprints, "System blueprint dictionary")
 		;
+
+	bindVectorView<std::vector<Augment>>(module, "AugmentList", "A list of augments (references the state, so nothing is copied)");
+	bindMapView<BlueprintMapWeapons>(module, "WeaponBlueprintDict", "A dictionary of weapon blueprints (references the state, so nothing is copied)");
+	bindMapView<BlueprintMapDrones>(module, "DroneBlueprintDict", "A dictionary of drone blueprints (references the state, so nothing is copied)");
+	bindMapView<BlueprintMapAugments>(module, "AugmentDict", "A dictionary of augment blueprints (references the state, so nothing is copied)");
+	bindMapView<BlueprintMapCrew>(module, "CrewBlueprintDict", "A dictionary of crew blueprints (references the state, so nothing is copied)");
+	bindMapView<BlueprintMapSystems>(module, "SystemBlueprintDict", "A dictionary of system blueprints (references the state, so nothing is copied)");
 }
 
 }
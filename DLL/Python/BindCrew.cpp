@@ -54,6 +54,8 @@ void bindCrew(py::module_& module)
 		.def_readonly("teleporting", &Crew::teleporting, "If the crewmember is teleporting")
 		.def_readonly("drone", &Crew::drone, "If the crewmember is a drone")
 		;
+
+	bindVectorView<std::vector<Crew>>(module, "CrewList", "A list of crew (references the state, so nothing is copied)");
 }
 
 }
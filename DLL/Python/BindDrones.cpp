@@ -74,6 +74,8 @@ void bindDrones(py::module_& module)
 		.def_readonly("set_up", &HackingDrone::setUp, "If the drone is set up")
 		.def_readonly("room", &HackingDrone::room, "The drone's targeted room")
 		;
+
+	bindVectorView<std::vector<Drone>>(module, "DroneList", "A list of drones (references the state, so nothing is copied)");
 }
 
 }
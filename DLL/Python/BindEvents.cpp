@@ -66,6 +66,9 @@ void bindEvents(py::module_& module)
 		.def_readonly("damage", &LocationEvent::damage, "The damage given by the event")
 		.def_readonly("choices", &LocationEvent::choices, "The choices for the player")
 		;
+
+	bindVectorView<std::vector<EventDamage>>(module, "EventDamageList", "A list of event damage (references the state, so nothing is copied)");
+	bindVectorView<std::vector<Choice>>(module, "ChoiceList", "A list of event choices (references the state, so nothing is copied)");
 }
 
 }
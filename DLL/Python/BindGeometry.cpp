@@ -133,6 +133,8 @@ void bindGeometry(py::module_& module)
 
 	//py::implicitly_convertible<Ellipse<float>, std::tuple<float, float, float, float>>();
 	py::implicitly_convertible<std::tuple<float, float, float, float>, Ellipse<float>>();
+
+	bindVectorView<std::vector<Rect<int>>>(module, "RectList", "A list of rectangles (references the state, so nothing is copied)");
 }
 
 }
@@ -2,9 +2,150 @@
 #include "../Input.hpp"
 #include "../State.hpp"
 
+#include <pybind11/numpy.h>
+
 namespace python_bindings
 {
 
+namespace
+{
+
+// What the commands return; unpacks like a tuple of (id, time) and can be awaited
+struct QueuedCommand
+{
+	Input::Ret id = 0;
+	double time = 0.0;
+};
+
+py::object inputModule()
+{
+	return py::module_::import("ftl").attr("input");
+}
+
+// Made the first time it's needed, then run a bit every frame by runEventLoop
+py::object eventLoop()
+{
+	auto&& input = inputModule();
+	py::object loop = input.attr("_event_loop");
+
+	if (loop.is_none())
+	{
+		auto&& asyncio = py::module_::import("asyncio");
+		loop = asyncio.attr("new_event_loop")();
+		asyncio.attr("set_event_loop")(loop);
+		input.attr("_event_loop") = loop;
+	}
+
+	return loop;
+}
+
+void resolve(py::handle future, const CommandResult& result)
+{
+	if (future.attr("done")().cast<bool>()) return; // cancelled
+
+	if (result.error.empty())
+	{
+		future.attr("set_result")(result);
+	}
+	else
+	{
+		py::object error = py::reinterpret_borrow<py::object>(PyExc_RuntimeError);
+		future.attr("set_exception")(error(result.error));
+	}
+}
+
+// Futures being awaited are kept on the module until their command finishes
+py::object commandFuture(Input::Ret id)
+{
+	py::dict futures = inputModule().attr("_futures");
+	py::int_ key(id);
+
+	if (futures.contains(key)) return futures[key];
+
+	py::object future = eventLoop().attr("create_future")();
+
+	// Nothing was queued, or it already finished
+	if (id == 0)
+	{
+		future.attr("set_result")(py::none());
+		return future;
+	}
+
+	if (auto result = Input::result(id))
+	{
+		resolve(future, *result);
+		return future;
+	}
+
+	futures[key] = future;
+	return future;
+}
+
+// Sets how commands are queued until it goes out of scope
+struct QueueOptions
+{
+	QueueOptions(double delay, CommandPriority priority, const std::string& tag)
+	{
+		Input::setDelay(delay);
+		Input::setPriority(priority);
+		Input::setTag(tag);
+	}
+
+	~QueueOptions()
+	{
+		Input::setDelay(0.0);
+		Input::setPriority(CommandPriority::Normal);
+		Input::setTag("");
+	}
+};
+
+// Adds the 'delay', 'priority' and 'tag' parameters to a command, and makes it return a QueuedCommand
+template<typename... Args>
+auto queued(Input::Ret(*command)(Args...))
+{
+	return [command](Args... args, double delay, CommandPriority priority, const std::string& tag) {
+		QueueOptions options(delay, priority, tag);
+		Input::Ret id = command(args...);
+		return QueuedCommand{ id, Input::due() };
+	};
+}
+
+// Same as queued, for the try_* commands, which return (status, Command)
+template<typename... Args>
+auto queued(Input::TryRet(*command)(Args...))
+{
+	return [command](Args... args, double delay, CommandPriority priority, const std::string& tag) {
+		QueueOptions options(delay, priority, tag);
+		auto [status, id] = command(args...);
+		return std::make_pair(status, QueuedCommand{ id, Input::due() });
+	};
+}
+
+}
+
+void runEventLoop()
+{
+	auto&& input = inputModule();
+	py::dict futures = input.attr("_futures");
+
+	// Always taken, so they don't pile up if nothing is awaited
+	for (auto&& result : Input::takeResults())
+	{
+		py::int_ key(result.id);
+		if (!futures.contains(key)) continue;
+
+		py::object future = futures.attr("pop")(key);
+		resolve(future, result);
+	}
+
+	py::object loop = input.attr("_event_loop");
+	if (loop.is_none()) return;
+
+	// Runs everything that's ready, then stops
+	loop.attr("call_soon")(loop.attr("stop"));
+	loop.attr("run_forever")();
+}
+
 void bindInput(py::module_& module)
 {
 	auto&& sub = module.def_submodule(
@@ -12,14 +153,174 @@ void bindInput(py::module_& module)
 		"Submodule for inputting into FTL\n\n"
 		"All methods that send commands take a parameter called 'delay'\n"
 		"which delays the input for that many seconds.\n"
-		"The methods will return the following in a tuple:\n"
+		"The methods will return a Command, which unpacks like a tuple of:\n"
 		"- the id of the commands in the queue\n"
 		"- the time the command will be executed\n"
-		"Time is in seconds and is relative to the start of PyFTL\n\n"
-		"Many methods also take a parameter called 'suppress_exceptions'\n"
-		"This stops PyFTL from throwing non-critical exceptions.\n"
-		"This allows erroneous inputs to be attempted, if possible.\n"
-		"An example of an erroneous input may be powering a system when you have no reactor power to spare."
+		"Time is in seconds and is relative to the start of PyFTL\n"
+		"Commands can also be awaited in coroutines started with ftl.spawn, see ftl.input.Command\n"
+		"Delayed commands don't hold up the rest of the queue, and don't count towards empty()\n\n"
+		"They also take 'priority' and 'tag':\n"
+		"- Priority.Urgent commands go before Priority.Normal ones, e.g. closing doors during a long trip through menus\n"
+		"  They wait for whatever command is partway through to finish first, so it isn't left half done\n"
+		"- the tag is any string, used to cancel a group of commands with cancel_tag\n\n"
+		"Commands that can't be done fail when they run, with the reason in their Result's error.\n"
+		"The try_* methods check first instead, and return (status, Command) rather than raising."
+	);
+
+	py::enum_<CommandPriority>(sub, "Priority", "Which queue a command goes in")
+		.value("Normal", CommandPriority::Normal)
+		.value("Urgent", CommandPriority::Urgent)
+		;
+
+	sub.attr("_futures") = py::dict();
+	sub.attr("_event_loop") = py::none();
+
+	py::class_<CommandResult>(sub, "Result", "What happened to a command once it finished")
+		.def_readonly("id", &CommandResult::id, "The id of the command")
+		.def_readonly("frame", &CommandResult::frame, "The frame it finished on, see ftl.input.frame")
+		.def_readonly("time", &CommandResult::time, "The time it finished, see ftl.now")
+		.def_readonly("error", &CommandResult::error, "Why it failed, or empty if it succeeded")
+		.def_property_readonly("ok", [](const CommandResult& r) { return r.error.empty(); }, "If it succeeded")
+		;
+
+	py::class_<QueuedCommand>(sub, "Command",
+		"A queued command, returned by every method that queues one (second in the tuple for the try_* methods)\n\n"
+		"Unpacks like a tuple, e.g. id, time = ftl.input.aim(0)\n"
+		"Awaiting it in a coroutine waits until it finishes, then gives a Result.\n"
+		"If it failed, a RuntimeError is raised instead.\n"
+		"Commands that queue other commands (e.g. aim clicking the mouse) finish once those have.\n"
+		"Only the last 1024 results are kept, so await it soon after queuing it.")
+		.def_readonly("id", &QueuedCommand::id, "The id of the command in the queue, or 0 if nothing was queued")
+		.def_readonly("time", &QueuedCommand::time, "The earliest time the command will be executed")
+		.def("__len__", [](const QueuedCommand&) { return 2; })
+		.def("__getitem__", [](const QueuedCommand& c, int i) {
+			return py::object(py::make_tuple(c.id, c.time)[py::int_(i)]);
+		})
+		.def("__iter__", [](const QueuedCommand& c) { return py::iter(py::make_tuple(c.id, c.time)); })
+		.def("__await__", [](const QueuedCommand& c) { return commandFuture(c.id).attr("__await__")(); })
+		.def("future", [](const QueuedCommand& c) { return commandFuture(c.id); },
+			"Gets an asyncio future that resolves like awaiting the command does")
+		.def("result", [](const QueuedCommand& c) { return Input::result(c.id); },
+			"Gets the result if it has finished, otherwise None")
+		.def("__repr__", [](const QueuedCommand& c) {
+			return "Command(id=" + std::to_string(c.id) + ", time=" + std::to_string(c.time) + ")";
+		})
+		;
+
+	module.def(
+		"spawn",
+		[](py::object coroutine) { return eventLoop().attr("create_task")(coroutine); },
+		py::arg("coroutine"),
+		"Starts a coroutine on PyFTL's asyncio event loop, which runs a bit every frame.\n"
+		"Returns the asyncio task."
+	);
+
+	module.def(
+		"event_loop",
+		&eventLoop,
+		"Gets PyFTL's asyncio event loop, which runs a bit every frame."
+	);
+
+	py::class_<VerificationStats>(sub, "Verification",
+		"How often a kind of command had the effect it was meant to on the state\n"
+		"Checked for power_system, power_weapon, door and select_crew")
+		.def_readonly("verified", &VerificationStats::verified, "How many had the effect, possibly after retrying")
+		.def_readonly("failed", &VerificationStats::failed, "How many didn't, even after retrying, or raised an exception")
+		.def_readonly("retries", &VerificationStats::retries, "How many times they were queued again")
+		.def_readonly("latency", &VerificationStats::latency, "Total seconds from first running to having the effect, for the verified ones")
+		.def_readonly("latency_frames", &VerificationStats::latencyFrames, "Same as latency, but in frames")
+		.def_property_readonly("success_rate", [](const VerificationStats& v) {
+			auto total = v.verified + v.failed;
+			return total ? double(v.verified) / double(total) : 1.0;
+		}, "The fraction that were verified")
+		.def_property_readonly("average_latency", [](const VerificationStats& v) {
+			return v.verified ? v.latency / double(v.verified) : 0.0;
+		}, "Average seconds to have the effect, for the verified ones")
+		;
+
+	sub.def(
+		"verification",
+		&Input::verification,
+		"Gets a dictionary of Verification by command name, e.g. 'power_system'.\n"
+		"Those commands are checked on the next few frames to see if the state changed like it should have.\n"
+		"If not (e.g. a click was eaten by something), they are queued again, see set_retries."
+	);
+
+	sub.def(
+		"reset_verification",
+		&Input::resetVerification,
+		"Resets the stats returned by verification."
+	);
+
+	sub.def(
+		"set_retries",
+		&Input::setRetries,
+		py::arg("retries"),
+		"Set how many times a command is queued again if it didn't have the effect it was meant to (2 by default)."
+	);
+
+	sub.def(
+		"retries",
+		&Input::retries,
+		"Get how many times a command is queued again if it didn't have the effect it was meant to."
+	);
+
+	py::class_<LatencyStats>(sub, "LatencyStats", "Percentiles of some latency, over the last 256 commands of a kind")
+		.def_readonly("count", &LatencyStats::count, "How many samples there are")
+		.def_readonly("p50", &LatencyStats::p50)
+		.def_readonly("p95", &LatencyStats::p95)
+		.def_readonly("p99", &LatencyStats::p99)
+		.def_readonly("max", &LatencyStats::max)
+		;
+
+	py::class_<CommandLatency>(sub, "CommandLatency",
+		"Latencies for a kind of command\n"
+		"All times are from when the command was queued, or when it was due if it had a delay")
+		.def_readonly("started", &CommandLatency::started, "Seconds until it started running")
+		.def_readonly("finished", &CommandLatency::finished, "Seconds until it and any commands it queued finished")
+		.def_readonly("confirmed", &CommandLatency::confirmed, "Seconds until its effect was seen in the state, see verification")
+		.def_readonly("confirmed_frames", &CommandLatency::confirmedFrames, "Frames from first running until its effect was seen in the state")
+		;
+
+	sub.def(
+		"stats",
+		&Input::latencyStats,
+		"Gets a dictionary of CommandLatency by kind of command, e.g. 'aim' or 'mouse'.\n"
+		"Only kinds of commands that have finished at least once are included."
+	);
+
+	sub.def(
+		"reset_stats",
+		&Input::resetLatencyStats,
+		"Resets the stats returned by stats."
+	);
+
+	sub.def(
+		"cancel",
+		&Input::cancel,
+		py::arg("id"),
+		"Removes a command from the queue if it hasn't started yet, returning if it was removed.\n"
+		"Awaiting it raises a RuntimeError."
+	);
+
+	sub.def(
+		"cancel_tag",
+		&Input::cancelTag,
+		py::arg("tag"),
+		"Removes every command with the tag that hasn't started yet, returning how many were removed."
+	);
+
+	sub.def(
+		"frame",
+		&Input::frame,
+		"Gets how many frames inputs have been made in."
+	);
+
+	sub.def(
+		"result",
+		&Input::result,
+		py::arg("id"),
+		"Gets the result of a command if it's one of the last 1024 to finish, otherwise None."
 	);
 
 	py::enum_<Key>(sub, "Key", "A keyboard key")
@@ -212,111 +513,184 @@ void bindInput(py::module_& module)
 		"Clears the input queue."
 	);
 
+	sub.def(
+		"set_budget",
+		&Input::setBudget,
+		py::arg("inputs"),
+		"Set the most raw mouse/keyboard inputs that can be made in one frame (1 by default).\n"
+		"Inputs that depend on the game having run a frame still wait for the next one:\n"
+		"clicks after the cursor moved, and any command that looks at the state (aim, power_system, etc.).\n"
+		"Raising this lowers the latency of queued commands, e.g. a mouse_click takes 2 frames instead of 3."
+	);
+
+	sub.def(
+		"allow_fused_clicks",
+		&Input::allowFusedClicks,
+		py::arg("allow") = true,
+		"Set if clicks can be made in the same frame as the mouse moving to them (off by default).\n"
+		"With a budget of at least 3, this makes a mouse_click take 1 frame instead of 2.\n"
+		"Some of the game's UI only notices the cursor moved once a frame passes, so clicks on it may be missed."
+	);
+
+	sub.def(
+		"fused_clicks_allowed",
+		&Input::fusedClicksAllowed,
+		"Check if clicks can be made in the same frame as the mouse moving to them."
+	);
+
+	sub.def(
+		"budget",
+		&Input::budget,
+		"Get the most raw mouse/keyboard inputs that can be made in one frame."
+	);
+
+	sub.def(
+		"delayed_count",
+		&Input::delayed,
+		"Get how many commands with a delay are still waiting to be due."
+	);
+
 	sub.def(
 		"dummy",
-		&Input::dummy,
+		queued(&Input::dummy),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Returns the value you get when an input function does nothing."
 	);
 
 	sub.def(
 		"wait",
-		&Input::wait,
+		queued(&Input::wait),
 		py::arg("time"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queues a command to wait before subsequent inputs in the queue are executed."
 	);
 
 	sub.def(
 		"mouse_move",
-		&Input::mouseMove,
+		queued(&Input::mouseMove),
 		py::arg("pos"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		py::kw_only(),
 		"Queue a command to move the mouse."
 	);
 
 	sub.def(
 		"mouse_down",
-		&Input::mouseDown,
+		queued(&Input::mouseDown),
 		py::arg("button") = MouseButton::Left,
 		py::arg("pos") = Point<int>(-1, -1),
 		py::kw_only(),
 		py::arg("shift") = false,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to hold a mouse button down.\n"
 		"Calls mouse_move before clicking. Default 'pos' argument makes mouse not move."
 	);
 
 	sub.def(
 		"mouse_up",
-		&Input::mouseUp,
+		queued(&Input::mouseUp),
 		py::arg("button") = MouseButton::Left,
 		py::arg("pos") = Point<int>(-1, -1),
 		py::kw_only(),
 		py::arg("shift") = false,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to release a mouse button.\n"
 		"Calls mouse_move before releasing. Default 'pos' argument makes mouse not move."
 	);
 
 	sub.def(
 		"mouse_click",
-		&Input::mouseClick,
+		queued(&Input::mouseClick),
 		py::arg("button") = MouseButton::Left,
 		py::arg("pos") = Point<int>(-1, -1),
 		py::kw_only(),
 		py::arg("shift") = false,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Calls mouse_move, mouse_down, and then mouse_up.\n"
 		"Calls mouse_move before releasing. Default 'pos' argument makes mouse not move."
 	);
 
 	sub.def(
 		"key_down",
-		&Input::keyDown,
+		queued(&Input::keyDown),
 		py::arg("key"),
 		py::kw_only(),
 		py::arg("shift") = false,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to hold a keyboard key down."
 	);
 
 	sub.def(
 		"key_up",
-		&Input::keyUp,
+		queued(&Input::keyUp),
 		py::arg("key"),
 		py::kw_only(),
 		py::arg("shift") = false,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to release a keyboard key."
 	);
 
 	sub.def(
 		"key_press",
-		&Input::keyPress,
+		queued(&Input::keyPress),
 		py::arg("key"),
 		py::kw_only(),
 		py::arg("shift") = false,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to press a keyboard key."
 	);
 
 	sub.def(
 		"hotkey_down",
-		&Input::hotkeyDown,
+		queued(&Input::hotkeyDown),
 		py::arg("hotkey"),
 		py::kw_only(),
 		py::arg("shift") = false,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to hold a named hotkey down."
 	);
 
 	sub.def(
 		"hotkey_up",
-		&Input::hotkeyUp,
+		queued(&Input::hotkeyUp),
 		py::arg("hotkey"),
 		py::kw_only(),
 		py::arg("shift") = false,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to release a named hotkey."
 	);
 
 	sub.def(
 		"hotkey_press",
-		&Input::hotkeyPress,
+		queued(&Input::hotkeyPress),
 		py::arg("hotkey"),
 		py::kw_only(),
 		py::arg("shift") = false,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to press a named hotkey."
 	);
 
@@ -329,63 +703,94 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"text",
-		py::overload_cast<const std::string&>(&Input::text),
+		queued(py::overload_cast<const std::string&>(&Input::text)),
 		py::arg("str"),
-		"Inputs a string of text into a text input"
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
+		"Inputs a string of text into a text input.\n"
+		"The whole string is one command, so it's typed in a single frame."
 	);
 
 	sub.def(
 		"text_confirm",
-		&Input::textConfirm,
+		queued(&Input::textConfirm),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Confirms the text entered into a text input"
 	);
 
 	sub.def(
 		"text_clear",
-		&Input::textClear,
+		queued(&Input::textClear),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Clears the text entered into a text input"
 	);
 
 	sub.def(
 		"text_backspace",
-		&Input::textBackspace,
+		queued(&Input::textBackspace),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Deletes the character before the cursor in a text input"
 	);
 
 	sub.def(
 		"text_delete",
-		&Input::textDelete,
+		queued(&Input::textDelete),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Deletes the character after the cursor in a text input"
 	);
 
 	sub.def(
 		"text_left",
-		&Input::textLeft,
+		queued(&Input::textLeft),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Moves the cursor one character to the left in a text input"
 	);
 
 	sub.def(
 		"text_right",
-		&Input::textLeft,
+		queued(&Input::textLeft),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Moves the cursor one character to the right in a text input"
 	);
 
 	sub.def(
 		"text_home",
-		&Input::textHome,
+		queued(&Input::textHome),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Moves the cursor to the beginning of a text input"
 	);
 
 	sub.def(
 		"text_end",
-		&Input::textEnd,
+		queued(&Input::textEnd),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Moves the cursor to the end of a text input"
 	);
 
 	sub.def(
 		"cheat",
-		&Input::cheat,
+		queued(&Input::cheat),
 		py::arg("command"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Are you a dirty cheater? Use this!\n"
 		"This effectively lets you use the game's built-in console without enabling/opening it.\n"
 		"This is not a queued input command and thus it will occur immediately.\n"
@@ -395,25 +800,34 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"pause",
-		&Input::pause,
+		queued(&Input::pause),
 		py::arg("on") = true,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Sets if the game is paused or not"
 	);
 
 	sub.def(
 		"event_choice",
-		&Input::choice,
+		queued(&Input::choice),
 		py::arg("which"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to select a choice at an event.\n"
 		"Events are zero-indexed, so pass in 0 for choice #1."
 	);
 
 	sub.def(
 		"power_system",
-		&Input::powerSystem,
+		queued(&Input::powerSystem),
 		py::arg("system"),
 		py::arg("set") = 0,
 		py::arg("which") = 0,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to change a system's power.\n"
 		"Power level will be set to 'set' if possible, otherwise an exception will be thrown.\n"
 		"If multiple of a system are present (i.e. artillery), specify 'which'.\n\n"
@@ -427,9 +841,12 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"power_weapon",
-		&Input::powerWeapon,
+		queued(&Input::powerWeapon),
 		py::arg("weapon"),
 		py::arg("on") = true,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to toggle a weapon.\n"
 		"By default it will turn the weapon on, set 'on' to false if you don't want this.\n\n"
 		"Inputs will be tried in the below order:\n"
@@ -439,9 +856,12 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"power_drone",
-		&Input::powerDrone,
+		queued(&Input::powerDrone),
 		py::arg("drone"),
 		py::arg("on") = true,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to toggle a drone.\n"
 		"By default it will turn the drone on, set 'on' to false if you don't want this.\n\n"
 		"Inputs will be tried in the below order:\n"
@@ -451,24 +871,33 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"select_weapon",
-		&Input::selectWeapon,
+		queued(&Input::selectWeapon),
 		py::arg("weapon"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to select a weapon."
 	);
 
 	sub.def(
 		"select_crew",
-		&Input::selectCrew,
+		queued(&Input::selectCrew),
 		py::arg("crew"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to select a group of crew members.\n"
 		"Note that the order of the list you pass in matters!"
 	);
 
 	sub.def(
 		"swap_weapons",
-		&Input::swapWeapons,
+		queued(&Input::swapWeapons),
 		py::arg("slot_a"),
 		py::arg("slot_b"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to swap two equipped weapons.\n"
 		"Works both in-game and in the cargo menu.\n"
 		"Will raise an exception if paused and not in the cargo menu."
@@ -476,9 +905,12 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"swap_drones",
-		&Input::swapDrones,
+		queued(&Input::swapDrones),
 		py::arg("slot_a"),
 		py::arg("slot_b"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to swap two equipped drones."
 		"Works both in-game and in the cargo menu.\n"
 		"Will raise an exception if paused and not in the cargo menu."
@@ -486,22 +918,31 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"crew_ability",
-		&Input::crewAbility,
+		queued(&Input::crewAbility),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to use the special abilities of all selected crew.\n"
 		"If a selected crewmember has no special ability, nothing happens."
 	);
 
 	sub.def(
 		"autofire",
-		&Input::autofire,
+		queued(&Input::autofire),
 		py::arg("on") = false,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to toggle auto-firing.\n"
 		"If not in the desired state, it tries the hotkey, then clicks the button."
 	);
 
 	sub.def(
 		"teleport_send",
-		&Input::teleportSend,
+		queued(&Input::teleportSend),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to select the teleport send function.\n"
 		"If not already selected, it tries the hotkey, then clicks the button.\n"
 		"This does not activate the teleporter immediately. Use the aim function."
@@ -509,7 +950,10 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"teleport_return",
-		&Input::teleportReturn,
+		queued(&Input::teleportReturn),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to select the teleport return function.\n"
 		"If not already selected, it tries the hotkey, then clicks the button.\n"
 		"This does not activate the teleporter immediately. Use the aim function."
@@ -517,21 +961,30 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"cloak",
-		&Input::cloak,
+		queued(&Input::cloak),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to activate cloaking.\n"
 		"It tries the hotkey, then clicks the button."
 	);
 
 	sub.def(
 		"battery",
-		&Input::battery,
+		queued(&Input::battery),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to activate the backup battery.\n"
 		"It tries the hotkey, then clicks the button."
 	);
 
 	sub.def(
 		"mind_control",
-		&Input::mindControl,
+		queued(&Input::mindControl),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to select the mind control function.\n"
 		"If not already selected, it tries the hotkey, then clicks the button.\n"
 		"This does not activate mind control immediately. Use the aim function."
@@ -539,7 +992,10 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"setup_hack",
-		&Input::setupHack,
+		queued(&Input::setupHack),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to begin picking a room to hack.\n"
 		"If not already selected, it tries the hotkey, then clicks the button.\n"
 		"This does not send the hacking drone immediately. Use the aim function."
@@ -547,16 +1003,22 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"hack",
-		&Input::hack,
+		queued(&Input::hack),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to begin hacking.\n"
 		"If not already selected, it tries the hotkey, then clicks the button."
 	);
 
 	sub.def(
 		"door",
-		&Input::door,
+		queued(&Input::door),
 		py::arg("door"),
 		py::arg("open"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to open/close a door.\n"
 		"Clicks on the door, if it's not in the desired state.\n"
 		"May raise an exception if the door is blocked"
@@ -564,9 +1026,12 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"door_all",
-		&Input::doorAll,
+		queued(&Input::doorAll),
 		py::arg("open") = false,
 		py::arg("airlocks") = false,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to open/close all doors.\n"
 		"Specify 'airlocks' to open airlocks too.\n"
 		"Tries the hotkey, then clicks the button."
@@ -574,10 +1039,13 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"aim",
-		py::overload_cast<int, bool, std::optional<bool>>(&Input::aim),
+		queued(py::overload_cast<int, bool, std::optional<bool>>(&Input::aim)),
 		py::arg("room"),
 		py::arg("self") = false,
 		py::arg("autofire") = std::nullopt,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to aim a weapon/system at a room.\n\n"
 		"This simply left clicks on a room, generally speaking.\n"
 		"You can target your own ship by setting 'self' to True.\n\n"
@@ -588,11 +1056,14 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"aim",
-		py::overload_cast<int, const Point<int>&, const Point<int>&, std::optional<bool>>(&Input::aim),
+		queued(py::overload_cast<int, const Point<int>&, const Point<int>&, std::optional<bool>>(&Input::aim)),
 		py::arg("room"),
 		py::arg("start"),
 		py::arg("end"),
 		py::arg("autofire") = std::nullopt,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to aim a beam weapon at a room.\n"
 		"Aiming anything else with this overload will raise an exception.\n\n"
 		"The start and end offsets are relative to the top left corner of the room.\n"
@@ -604,85 +1075,121 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"deselect",
-		&Input::deselect,
+		queued(&Input::deselect),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to deselect weapons/systems/crew.\n"
 		"What it actually does is it left/right clicks in a spot that does nothing."
 	);
 
 	sub.def(
 		"send_crew",
-		&Input::sendCrew,
+		queued(&Input::sendCrew),
 		py::arg("room"),
 		py::arg("self") = true,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to send the currently selected crew to a room.\n"
 		"You can target the enemy ship by setting 'self' to False."
 	);
 
 	sub.def(
 		"save_stations",
-		&Input::saveStations,
+		queued(&Input::saveStations),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to save the stations of the player crew.\n"
 		"Tries the hotkey first, then clicks the button."
 	);
 
 	sub.def(
 		"load_stations",
-		&Input::loadStations,
+		queued(&Input::loadStations),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to load the stations of the player crew.\n"
 		"Tries the hotkey first, then clicks the button."
 	);
 
 	sub.def(
 		"jump",
-		&Input::jump,
+		queued(&Input::jump),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to jump.\n"
 		"Tries the hotkey first, then clicks the button."
 	);
 
 	sub.def(
 		"leave_crew",
-		&Input::leaveCrew,
+		queued(&Input::leaveCrew),
 		py::arg("yes"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to answer the dialog to confirm leaving boarding crew behind.\n"
 		"The dialog must have already popped up, or an exception will be raised."
 	);
 
 	sub.def(
 		"upgrades",
-		&Input::upgrades,
+		queued(&Input::upgrades),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to open the upgrades menu."
 	);
 
 	sub.def(
 		"crew_manifest",
-		&Input::crewManifest,
+		queued(&Input::crewManifest),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to open the crew menu."
 	);
 
 	sub.def(
 		"cargo",
-		&Input::cargo,
+		queued(&Input::cargo),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to open the cargo menu."
 	);
 
 	sub.def(
 		"store",
-		&Input::store,
+		queued(&Input::store),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to open the store menu."
 	);
 
 	sub.def(
 		"menu",
-		&Input::menu,
+		queued(&Input::menu),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to open the pause menu."
 	);
 
 	sub.def(
 		"upgrade_system",
-		&Input::upgradeSystem,
+		queued(&Input::upgradeSystem),
 		py::arg("system"),
 		py::arg("to"),
 		py::arg("which") = 0,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to upgrade a system to the specified level.\n"
 		"Specify 'which' if there's multiple of that system.\n"
 		"You can also use this to remove upgrades from a system,\n"
@@ -692,8 +1199,11 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"upgrade_reactor",
-		&Input::upgradeReactor,
+		queued(&Input::upgradeReactor),
 		py::arg("to"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to upgrade the reactor to the specified level.\n"
 		"You can also use this to remove upgrades from the reactor,\n"
 		"so long as you haven't closed the upgrade menu.\n\n"
@@ -702,64 +1212,88 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"undo_upgrades",
-		&Input::undoUpgrades,
+		queued(&Input::undoUpgrades),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to click the button to undo all upgrades.\n"
 		"You must already be in the upgrade menu, or an exception will be raised."
 	);
 
 	sub.def(
 		"rename_crew",
-		&Input::renameCrew,
+		queued(&Input::renameCrew),
 		py::arg("which"),
 		py::arg("name"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to rename a crewmember.\n"
 		"You must already be in the crew manifest, or an exception will be raised."
 	);
 
 	sub.def(
 		"dismiss_crew",
-		&Input::dismissCrew,
+		queued(&Input::dismissCrew),
 		py::arg("which"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to dismiss a crewmember.\n"
 		"You must already be in the crew manifest, or an exception will be raised."
 	);
 
 	sub.def(
 		"confirm_dismiss_crew",
-		&Input::confirmDismissCrew,
+		queued(&Input::confirmDismissCrew),
 		py::arg("yes"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to confirm dismissing a crewmember.\n"
 		"The confirmation window must be open, or an exception will be raised."
 	);
 
 	sub.def(
 		"swap_cargo",
-		&Input::swapCargo,
+		queued(&Input::swapCargo),
 		py::arg("slot_a"),
 		py::arg("slot_b"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to swap two unequipped weapons/drones in storage."
 	);
 
 	sub.def(
 		"swap_weapon_cargo",
-		&Input::swapWeaponCargo,
+		queued(&Input::swapWeaponCargo),
 		py::arg("weapon_slot"),
 		py::arg("cargo_slot"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to swap an equipped weapon with one in storage."
 	);
 
 	sub.def(
 		"swap_drone_cargo",
-		&Input::swapDroneCargo,
+		queued(&Input::swapDroneCargo),
 		py::arg("drone_slot"),
 		py::arg("cargo_slot"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to swap an equipped drone with one in storage."
 	);
 
 	sub.def(
 		"discard_cargo",
-		&Input::discardCargo,
+		queued(&Input::discardCargo),
 		py::arg("slot"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to discard the cargo in the specified storage slot.\n"
 		"This leaves items behind at beacons if there's over-capacity.\n"
 		"This also sells items at stores.\n"
@@ -768,8 +1302,11 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"discard_cargo",
-		&Input::discardCargo,
+		queued(&Input::discardCargo),
 		py::arg("slot"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to discard the cargo in the specified storage slot.\n"
 		"This leaves cargo behind at beacons if there's over-capacity.\n"
 		"This also sells cargo at stores.\n"
@@ -778,8 +1315,11 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"discard_weapon",
-		&Input::discardWeapon,
+		queued(&Input::discardWeapon),
 		py::arg("slot"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to discard the weapon in the specified weapon slot.\n"
 		"NOTE: Weapons will automatically shift to the left-most slot afterwards!\n"
 		"This leaves weapons behind at beacons if there's over-capacity.\n"
@@ -789,8 +1329,11 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"discard_drone",
-		&Input::discardDrone,
+		queued(&Input::discardDrone),
 		py::arg("slot"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to discard the drone in the specified drone slot.\n"
 		"NOTE: Drones will automatically shift to the left-most slot afterwards!\n"
 		"This leaves drones behind at beacons if there's over-capacity.\n"
@@ -800,8 +1343,11 @@ void bindInput(py::module_& module)
 
 	sub.def(
 		"discard_augment",
-		&Input::discardAugment,
+		queued(&Input::discardAugment),
 		py::arg("slot"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
 		"Queue a command to discard the augment in the specified augment slot.\n"
 		"NOTE: Augments will automatically shift to the left-most slot afterwards!\n"
 		"This leaves augments behind at beacons if there's over-capacity.\n"
@@ -809,6 +1355,248 @@ void bindInput(py::module_& module)
 		"If neither of these are the case, an exception is raised."
 	);
 
+	sub.def(
+		"can_power_system",
+		&Input::canPowerSystem,
+		py::arg("system"),
+		py::arg("set") = 0,
+		py::arg("which") = 0,
+		"Checks if power_system would currently succeed, without queuing anything."
+	);
+
+	sub.def(
+		"can_power_weapon",
+		&Input::canPowerWeapon,
+		py::arg("weapon"),
+		py::arg("on") = true,
+		"Checks if power_weapon would currently succeed, without queuing anything."
+	);
+
+	sub.def(
+		"can_select_weapon",
+		&Input::canSelectWeapon,
+		py::arg("weapon"),
+		"Checks if select_weapon would currently succeed, without queuing anything."
+	);
+
+	sub.def(
+		"can_aim_weapon",
+		&Input::canAimWeapon,
+		py::arg("weapon"),
+		py::arg("room"),
+		py::arg("self") = false,
+		"Checks if selecting a weapon and then aiming it at a room would currently succeed, without queuing anything."
+	);
+
+	sub.def(
+		"can_aim",
+		&Input::canAim,
+		py::arg("room"),
+		py::arg("self") = false,
+		"Checks if aim would currently succeed with whatever is selected, without queuing anything."
+	);
+
+	sub.def(
+		"can_send_crew",
+		&Input::canSendCrew,
+		py::arg("room"),
+		py::arg("self") = true,
+		"Checks if send_crew would currently succeed, without queuing anything."
+	);
+
+	sub.def(
+		"can_door",
+		&Input::canDoor,
+		py::arg("door"),
+		py::arg("open"),
+		"Checks if door would currently succeed, without queuing anything."
+	);
+
+	sub.def(
+		"can_choice",
+		&Input::canChoice,
+		py::arg("which"),
+		"Checks if choice would currently succeed, without queuing anything."
+	);
+
+	sub.def(
+		"legal_actions",
+		[]() {
+			auto&& actions = Input::legalActions();
+
+			auto toArray = [](auto&& table, std::vector<py::ssize_t> shape) {
+				return py::array_t<bool>(shape, reinterpret_cast<const bool*>(table.data()));
+			};
+
+			constexpr py::ssize_t weapons = LegalActions::MAX_WEAPONS;
+			constexpr py::ssize_t rooms = LegalActions::MAX_ROOMS;
+
+			py::dict dict;
+			dict["power"] = toArray(actions.power, { py::ssize_t(LegalActions::SYSTEMS), LegalActions::MAX_POWER + 1 });
+			dict["weapon_power"] = toArray(actions.weaponPower, { weapons, 2 });
+			dict["aim_weapon"] = toArray(actions.aimWeapon, { weapons, 2, rooms });
+			dict["send_crew"] = toArray(actions.sendCrew, { 2, rooms });
+			dict["door"] = toArray(actions.door, { LegalActions::MAX_DOORS, 2 });
+			dict["choice"] = toArray(actions.choice, { LegalActions::MAX_CHOICES });
+			return dict;
+		},
+		"Gets which actions would currently succeed, as a dictionary of NumPy bool arrays:\n"
+		"- power[system type][power level]: power_system(system, level)\n"
+		"- weapon_power[weapon][off/on]: power_weapon(weapon, on)\n"
+		"- aim_weapon[weapon][ship][room]: select_weapon(weapon), then aim(room, self)\n"
+		"- send_crew[ship][room]: send_crew(room, self)\n"
+		"- door[door][close/open]: door(door, open)\n"
+		"- choice[choice]: choice(which)\n"
+		"Ship 0 is the player ship and ship 1 is the enemy ship.\n"
+		"Anything past the end of a list (no such weapon, room, door, etc.) is False."
+	);
+
+	py::enum_<CommandStatus>(sub, "Status", "Why a command would or wouldn't be accepted")
+		.value("Ok", CommandStatus::Ok)
+		.value("GameNotRunning", CommandStatus::GameNotRunning)
+		.value("WrongMenu", CommandStatus::WrongMenu)
+		.value("SystemNotInstalled", CommandStatus::SystemNotInstalled)
+		.value("InvalidSlot", CommandStatus::InvalidSlot)
+		.value("EmptySlot", CommandStatus::EmptySlot)
+		.value("NotPowered", CommandStatus::NotPowered)
+		.value("InvalidPower", CommandStatus::InvalidPower)
+		.value("NotEnoughPower", CommandStatus::NotEnoughPower)
+		.value("NotEnoughMissiles", CommandStatus::NotEnoughMissiles)
+		.value("ZoltanPowered", CommandStatus::ZoltanPowered)
+		.value("InvalidRoom", CommandStatus::InvalidRoom)
+		.value("InvalidSelfAim", CommandStatus::InvalidSelfAim)
+		.value("InvalidArgument", CommandStatus::InvalidArgument)
+		.value("NotSelected", CommandStatus::NotSelected)
+		.value("WrongShip", CommandStatus::WrongShip)
+		.value("DoorInoperable", CommandStatus::DoorInoperable)
+		.value("NoEvent", CommandStatus::NoEvent)
+		.value("InvalidChoice", CommandStatus::InvalidChoice)
+		.value("InvalidSwap", CommandStatus::InvalidSwap)
+		;
+
+	sub.def(
+		"status_message",
+		&commandStatusMessage,
+		py::arg("status"),
+		"Gets a short description of a status."
+	);
+
+	sub.def(
+		"try_power_system",
+		queued(&Input::tryPowerSystem),
+		py::arg("system"),
+		py::arg("set") = 0,
+		py::arg("which") = 0,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
+		"Like power_system, but checks it first instead of raising an exception later.\n"
+		"Returns (status, command); the command is only queued if the status is Status.Ok, otherwise its id is 0.\n"
+		"The command can be awaited the same as one that was queued without checking."
+	);
+
+	sub.def(
+		"try_power_weapon",
+		queued(&Input::tryPowerWeapon),
+		py::arg("weapon"),
+		py::arg("on") = true,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
+		"Like power_weapon, but checks it first instead of raising an exception later.\n"
+		"Returns (status, command); the command is only queued if the status is Status.Ok, otherwise its id is 0.\n"
+		"The command can be awaited the same as one that was queued without checking."
+	);
+
+	sub.def(
+		"try_select_weapon",
+		queued(&Input::trySelectWeapon),
+		py::arg("weapon"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
+		"Like select_weapon, but checks it first instead of raising an exception later.\n"
+		"Returns (status, command); the command is only queued if the status is Status.Ok, otherwise its id is 0.\n"
+		"The command can be awaited the same as one that was queued without checking."
+	);
+
+	sub.def(
+		"try_aim",
+		queued(&Input::tryAim),
+		py::arg("room"),
+		py::arg("self") = false,
+		py::arg("autofire") = std::nullopt,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
+		"Like aim, but checks it first instead of raising an exception later.\n"
+		"Returns (status, command); the command is only queued if the status is Status.Ok, otherwise its id is 0.\n"
+		"The command can be awaited the same as one that was queued without checking."
+	);
+
+	sub.def(
+		"try_send_crew",
+		queued(&Input::trySendCrew),
+		py::arg("room"),
+		py::arg("self") = true,
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
+		"Like send_crew, but checks it first instead of raising an exception later.\n"
+		"Returns (status, command); the command is only queued if the status is Status.Ok, otherwise its id is 0.\n"
+		"The command can be awaited the same as one that was queued without checking."
+	);
+
+	sub.def(
+		"try_door",
+		queued(&Input::tryDoor),
+		py::arg("door"),
+		py::arg("open"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
+		"Like door, but checks it first instead of raising an exception later.\n"
+		"Returns (status, command); the command is only queued if the status is Status.Ok, otherwise its id is 0.\n"
+		"The command can be awaited the same as one that was queued without checking."
+	);
+
+	sub.def(
+		"try_choice",
+		queued(&Input::tryChoice),
+		py::arg("which"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
+		"Like choice, but checks it first instead of raising an exception later.\n"
+		"Returns (status, command); the command is only queued if the status is Status.Ok, otherwise its id is 0.\n"
+		"The command can be awaited the same as one that was queued without checking."
+	);
+
+	sub.def(
+		"try_swap_weapons",
+		queued(&Input::trySwapWeapons),
+		py::arg("slot_a"),
+		py::arg("slot_b"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
+		"Like swap_weapons, but checks it first instead of raising an exception later.\n"
+		"Returns (status, command); the command is only queued if the status is Status.Ok, otherwise its id is 0.\n"
+		"The command can be awaited the same as one that was queued without checking."
+	);
+
+	sub.def(
+		"try_discard_cargo",
+		queued(&Input::tryDiscardCargo),
+		py::arg("slot"),
+		py::arg("delay") = 0.0,
+		py::arg("priority") = CommandPriority::Normal,
+		py::arg("tag") = "",
+		"Like discard_cargo, but checks it first instead of raising an exception later.\n"
+		"Returns (status, command); the command is only queued if the status is Status.Ok, otherwise its id is 0.\n"
+		"The command can be awaited the same as one that was queued without checking."
+	);
+
 }
 
 }
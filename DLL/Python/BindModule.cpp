@@ -20,6 +20,8 @@ void bindSettings(py::module_& module);
 void bindBlueprints(py::module_& module);
 void bindUI(py::module_& module);
 void bindInput(py::module_& module);
+void bindArrays(py::module_& module);
+void bindObservation(py::module_& module);
 
 }
 
@@ -46,4 +48,6 @@ PYBIND11_EMBEDDED_MODULE(ftl, module)
 	bindBlueprints(module);
 	bindUI(module);
 	bindInput(module);
+	bindArrays(module);
+	bindObservation(module);
 }
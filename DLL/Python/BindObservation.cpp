@@ -0,0 +1,75 @@
+#include "Bind.hpp"
+#include "../Observation.hpp"
+#include "../Reader.hpp"
+
+#include <pybind11/numpy.h>
+
+namespace python_bindings
+{
+
+void bindObservation(py::module_& module)
+{
+	py::class_<ObservationEncoder, std::shared_ptr<ObservationEncoder>>(module, "ObservationEncoder",
+		"Turns the state into a fixed-size float32 array, for feeding to models\n\n"
+		"Each argument lists the fields to include, named like the attributes on the state objects.\n"
+		"Things that don't exist (no enemy ship, fewer rooms than max_rooms, etc.) are filled with 'padding'.\n"
+		"The 'present' field is 1 for things that exist, so it can be used to tell them apart.\n"
+		"Every system type gets a spot on each ship, in SystemType order.")
+		.def(py::init([](
+			const std::vector<std::string>& ship,
+			const std::vector<std::string>& systems,
+			const std::vector<std::string>& rooms,
+			int maxRooms,
+			const std::vector<std::string>& crew,
+			int maxCrew,
+			const std::vector<std::string>& projectiles,
+			int maxProjectiles,
+			float padding)
+			{
+				return std::make_shared<ObservationEncoder>(ObservationSchema{
+					.ship = ship,
+					.systems = systems,
+					.rooms = rooms,
+					.crew = crew,
+					.projectiles = projectiles,
+					.maxRooms = maxRooms,
+					.maxCrew = maxCrew,
+					.maxProjectiles = maxProjectiles,
+					.padding = padding
+				});
+			}),
+			py::kw_only(),
+			py::arg("ship") = std::vector<std::string>{},
+			py::arg("systems") = std::vector<std::string>{},
+			py::arg("rooms") = std::vector<std::string>{},
+			py::arg("max_rooms") = 0,
+			py::arg("crew") = std::vector<std::string>{},
+			py::arg("max_crew") = 0,
+			py::arg("projectiles") = std::vector<std::string>{},
+			py::arg("max_projectiles") = 0,
+			py::arg("padding") = 0.f
+		)
+		.def("encode", &ObservationEncoder::encode, py::arg("state"), "Encodes a state into the tensor; done automatically every frame if set with ftl.set_observation_encoder")
+		.def("tensor", [](py::object self) {
+			auto&& encoder = self.cast<const ObservationEncoder&>();
+			return py::array_t<float>(py::ssize_t(encoder.size()), encoder.data(), self);
+		}, "Gets the tensor as a NumPy array; it's a view, so it changes whenever the state is encoded")
+		.def("labels", &ObservationEncoder::labels, "Gets the name of each value in the tensor")
+		.def("__len__", &ObservationEncoder::size)
+		;
+
+	module.def(
+		"set_observation_encoder",
+		&Reader::setObservationEncoder,
+		py::arg("encoder"),
+		"Sets an encoder to run after every read of the game's memory, or None to stop"
+	);
+
+	module.def(
+		"observation_encoder",
+		&Reader::observationEncoder,
+		"Gets the encoder that runs after every read, if any"
+	);
+}
+
+}
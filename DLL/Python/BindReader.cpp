@@ -19,6 +19,31 @@ void bindReader(py::module_& module)
 		"Returns how long PyFTL has been running in seconds"
 	);
 
+	module.def(
+		"read_time",
+		&Reader::readTime,
+		"Returns how long the last read of the game's memory took in seconds (the game waits on this every frame)"
+	);
+
+	module.def(
+		"read_allocations",
+		&Reader::readAllocations,
+		"Returns how many heap allocations the last read of the game's memory made"
+	);
+
+	module.def(
+		"set_parallel_read",
+		&Reader::setParallelRead,
+		py::arg("on") = true,
+		"Sets if independent parts of the state (space, crew, ships) are read on worker threads"
+	);
+
+	module.def(
+		"parallel_read",
+		&Reader::parallelRead,
+		"Checks if independent parts of the state are read on worker threads"
+	);
+
 	module.def(
 		"reload",
 		&Reader::reload,
@@ -1,5 +1,6 @@
 #include "Bind.hpp"
 #include "../State/Ship.hpp"
+#include "../ShipGraph.hpp"
 
 namespace python_bindings
 {
@@ -55,12 +56,15 @@ void bindShip(py::module_& module)
 		.def_readonly("battery", &Ship::battery, "The ship's backup battery system")
 		.def_readonly("rooms", &Ship::rooms, "The ship's rooms")
 		.def_readonly("doors", &Ship::doors, "The ship's doors")
+		.def_readonly("graph", &Ship::graph, "The walking distances between the ship's slots")
 		.def_readonly("cargo", &Ship::cargo, "The ship's inventory")
 		.def("has_system", &Ship::hasSystem, "Checks if the specified system is present")
 		.def("get_system", &Ship::getSystem, py::return_value_policy::reference, "Gets the specified system")
 		.def("system_count", &Ship::systemCount, "Gets the number of systems present (excluding subsystems)")
 		.def("subsystem_count", &Ship::subsystemCount, "Gets the number of subsystems present")
 		;
+
+	bindVectorView<std::vector<CargoItem>>(module, "CargoItemList", "A list of weapon/drone storage slots (references the state, so nothing is copied)");
 }
 
 }
@@ -1,5 +1,6 @@
 #include "Bind.hpp"
 #include "../State/Ship.hpp"
+#include "../ShipGraph.hpp"
 
 namespace python_bindings
 {
@@ -72,6 +73,26 @@ void bindShipLayout(py::module_& module)
 		.def_readonly("player", &Door::player, "If the door belongs to the player")
 		.def_readonly("rect", &Door::rect, "The rectangle bounding the door")
 		;
+
+	py::class_<ShipGraph, std::shared_ptr<ShipGraph>>(module, "ShipGraph",
+		"The walking distances between every pair of slots in a ship, worked out ahead of time\n\n"
+		"Distances are in pixels at 1280x720, and inf if blocked doors cut the slots off from each other.\n"
+		"Each ship has its own graph, which is kept for as long as the ship's layout doesn't change.")
+		.def_readonly_static("UNREACHABLE", &ShipGraph::UNREACHABLE, "The distance between slots that can't reach each other")
+		.def("distance", &ShipGraph::distance, py::arg("room_a"), py::arg("slot_a"), py::arg("room_b"), py::arg("slot_b"), "Gets the walking distance from one slot to another")
+		.def("node_distance", &ShipGraph::nodeDistance, py::arg("a"), py::arg("b"), "Gets the walking distance between two nodes")
+		.def("node", &ShipGraph::node, py::arg("room"), py::arg("slot"), "Gets the node of a slot, or -1 if there's no such slot")
+		.def("slot_of", &ShipGraph::slotOf, py::arg("node"), "Gets the room and slot of a node")
+		.def("node_count", &ShipGraph::nodeCount, "Gets the number of nodes (slots) in the graph")
+		.def("set_door_blocked", &ShipGraph::setDoorBlocked, py::arg("door"), py::arg("blocked") = true, "Stops (or lets) crew walk through a door, updating the distances")
+		.def("door_blocked", &ShipGraph::doorBlocked, py::arg("door"), "Checks if a door is blocked")
+		.def("blocked_doors", &ShipGraph::blockedDoors, "Gets the ids of the blocked doors")
+		.def("unblock_doors", &ShipGraph::unblockDoors, "Unblocks every door")
+		;
+
+	bindVectorView<std::vector<Slot>>(module, "SlotList", "A list of slots (references the state, so nothing is copied)");
+	bindVectorView<std::vector<Room>>(module, "RoomList", "A list of rooms (references the state, so nothing is copied)");
+	bindVectorView<std::vector<Door>>(module, "DoorList", "A list of doors (references the state, so nothing is copied)");
 }
 
 }
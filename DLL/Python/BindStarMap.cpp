@@ -59,6 +59,9 @@ void bindStarMap(py::module_& module)
 		.def_readonly("distress_beacon", &StarMap::distressBeacon, "If the player's distress beacon is on")
 		.def_readonly("sector_number", &StarMap::sectorNumber, "The number of the current sector")
 		;
+
+	bindVectorView<std::vector<Location>>(module, "LocationList", "A list of locations (references the state, so nothing is copied)");
+	bindVectorView<std::vector<Sector>>(module, "SectorList", "A list of sectors (references the state, so nothing is copied)");
 }
 
 }
@@ -39,6 +39,8 @@ void bindStores(py::module_& module)
 		.def_readonly("repair_cost", &Store::repairCost, "Repair price")
 		.def_readonly("repair_cost_full", &Store::repairCostFull, "Price to repair all damage")
 		;
+
+	bindVectorView<std::vector<StoreBox>>(module, "StoreBoxList", "A list of store boxes (references the state, so nothing is copied)");
 }
 
 }
@@ -159,6 +159,8 @@ void bindSystems(py::module_& module)
 		.def_readonly("ion_timer", &Power::ionTimer, "The time left to remove one level of ionization")
 		.def_readonly("restore_to", &Power::restoreTo, "The power level to restore the system to once repaired/ionization wears off")
 		;
+
+	bindVectorView<std::vector<ArtillerySystem>>(module, "ArtillerySystemList", "A list of artillery systems (references the state, so nothing is copied)");
 }
 
 }
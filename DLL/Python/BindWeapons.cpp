@@ -106,6 +106,9 @@ void bindWeapons(py::module_& module)
 		.def_readonly("beam", &Projectile::beam, "Beam-specific info")
 		.def_readonly("bomb", &Projectile::bomb, "Bomb-specific info")
 		;
+
+	bindVectorView<std::vector<Weapon>>(module, "WeaponList", "A list of weapons (references the state, so nothing is copied)");
+	bindVectorView<std::vector<Projectile>>(module, "ProjectileList", "A list of projectiles (references the state, so nothing is copied)");
 }
 
 }
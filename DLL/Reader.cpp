@@ -4,14 +4,24 @@
 
 #include "Reader.hpp"
 #include "Input.hpp"
+#include "ShipGraph.hpp"
 #include "Utility/Memory.hpp"
 #include "Utility/Exceptions.hpp"
+#include "Utility/AllocationCounter.hpp"
 
 #include <algorithm>
 #include <unordered_map>
+#include <unordered_set>
+#include <mutex>
 #include <concepts>
+#include <span>
+#include <memory_resource>
 
 Reader::TimePoint Reader::start = Reader::Clock::now();
+Reader::Duration Reader::lastRead{};
+uintmax_t Reader::lastReadAllocations = 0;
+std::unique_ptr<TaskPool> Reader::pool;
+std::shared_ptr<ObservationEncoder> Reader::encoder;
 raw::State Reader::rs;
 State Reader::state;
 uintptr_t Reader::base = 0;
@@ -29,6 +39,125 @@ int calculatePowerCap(int max, int cap, int loss, int divide)
 	return std::min(std::min(capQuotient, capDiff), cap);
 }
 
+// Memory for temporary containers used while reading
+// It's on the stack, so it's freed all at once when done with, and it's safe to use from any thread
+// Only goes to the heap if it runs out
+template<size_t N>
+struct ScratchArena
+{
+	std::array<std::byte, N> buffer;
+	std::pmr::monotonic_buffer_resource resource{ this->buffer.data(), this->buffer.size() };
+};
+
+// Most of the state is read from scratch every frame
+// Rather than destroying the old objects and making new ones, they're reset with recycle,
+// which keeps the memory of the vectors inside them around for the next read
+template<typename T>
+void recycle(T& obj)
+{
+	obj = T{};
+}
+
+void recycle(Crew& crew)
+{
+	auto doors = std::move(crew.path.doors);
+	crew = Crew{};
+	crew.path.doors = std::move(doors);
+	crew.path.doors.clear();
+}
+
+void recycle(Weapon& weapon)
+{
+	auto targetPoints = std::move(weapon.targetPoints);
+	weapon = Weapon{};
+	weapon.targetPoints = std::move(targetPoints);
+	weapon.targetPoints.clear();
+}
+
+void recycle(Room& room)
+{
+	auto slots = std::move(room.slots);
+	auto crew = std::move(room.crew);
+	auto intruders = std::move(room.intruders);
+	room = Room{};
+	room.slots = std::move(slots);
+	room.crew = std::move(crew);
+	room.intruders = std::move(intruders);
+	room.slots.clear();
+	room.crew.clear();
+	room.intruders.clear();
+}
+
+// Resizes a list that's about to be read into, recycling the objects that are kept
+template<typename T>
+void recycleList(std::vector<T>& list, size_t size)
+{
+	if (list.size() > size) list.resize(size);
+	for (auto&& obj : list) recycle(obj);
+	list.resize(size);
+}
+
+void readBlueprint(Blueprint& blueprint, const raw::Blueprint& raw)
+{
+	blueprint.name = raw.name.str;
+	blueprint.cost = raw.desc.cost;
+	blueprint.rarity = raw.desc.rarity;
+	blueprint.baseRarity = raw.desc.baseRarity;
+}
+
+void readRuntimeBlueprint(WeaponBlueprint& blueprint, const raw::Blueprint& raw);
+void readRuntimeBlueprint(DroneBlueprint& blueprint, const raw::Blueprint& raw);
+void readRuntimeBlueprint(Augment& blueprint, const raw::Blueprint& raw);
+void readRuntimeBlueprint(SystemBlueprint& blueprint, const raw::Blueprint& raw);
+
+// Finds the blueprint that was read from one of the game's blueprints
+// Anything the game made outside its blueprint tables is looked up by name instead,
+// and if that fails too it's read from the game into a store kept with the blueprints
+template<typename T>
+const T* findBlueprint(const std::map<std::string, T>& map, const raw::Blueprint& raw)
+{
+	auto&& blueprints = Reader::getState().blueprints;
+	auto it = blueprints._byRaw.find(&raw);
+
+	if (it != blueprints._byRaw.end()) return static_cast<const T*>(it->second);
+
+	auto named = map.find(raw.name.str);
+
+	if (named != map.end()) return &named->second;
+
+	// Both ships are read at the same time, so this has to be locked
+	static std::mutex mutex;
+	std::lock_guard lock(mutex);
+
+	// Re-read once per read, since the game may free one of these and reuse its address
+	// Only once, since the other ship may already be reading from it
+	auto&& stored = blueprints._runtime[&raw];
+	auto* blueprint = std::get_if<T>(&stored.blueprint);
+
+	if (!blueprint)
+	{
+		blueprint = &stored.blueprint.template emplace<T>();
+		stored.generation = 0;
+	}
+
+	if (stored.generation != blueprints._generation)
+	{
+		readRuntimeBlueprint(*blueprint, raw);
+		stored.generation = blueprints._generation;
+	}
+
+	return blueprint;
+}
+
+const SystemBlueprint* findSystemBlueprint(SystemType type)
+{
+	auto* blueprint = Reader::getState().blueprints._systems.at(size_t(type));
+
+	if (!blueprint) throw std::out_of_range("no blueprint for the " + systemName(type) + " system");
+
+	return blueprint;
+}
+
 void readPower(Power& power, const raw::ShipSystem& raw)
 {
 	power.required = raw.iRequiredPower;
@@ -55,7 +184,7 @@ void readPower(Power& power, const raw::ShipSystem& raw)
 void readSystem(System& system, const raw::ShipSystem& raw)
 {
 	readPower(system.power, raw);
-	system.blueprint = Reader::getState().blueprints.systemBlueprints.at(raw.name.str);
+	system.blueprint = findSystemBlueprint(SystemType(raw.iSystemType));
 
 	system.type = SystemType(raw.iSystemType);
 	system.room = raw.roomId;
@@ -91,7 +220,6 @@ void readSystem(System& system, const raw::ShipSystem& raw)
 void readShieldSystem(ShieldSystem& shields, const raw::Shields& raw, const Point<int>& offset)
 {
 	readSystem(shields, raw);
-	shields.blueprint = Reader::getState().blueprints.systemBlueprints.at("shields");
 
 	shields.boundary = raw.baseShield;
 
@@ -109,7 +237,6 @@ void readShieldSystem(ShieldSystem& shields, const raw::Shields& raw, const Poin
 void readEngineSystem(EngineSystem& engines, const raw::EngineSystem& raw)
 {
 	readSystem(engines, raw);
-	engines.blueprint = Reader::getState().blueprints.systemBlueprints.at("engines");
 
 	engines.boostFTL = raw.bBoostFTL;
 }
@@ -133,7 +260,6 @@ void readClonebaySystem(
 	std::vector<Crew>& crew)
 {
 	readSystem(clonebay, raw);
-	clonebay.blueprint = Reader::getState().blueprints.systemBlueprints.at("clonebay");
 
 	clonebay.cloneTimer = {
 		raw.fTimeToClone,
@@ -176,40 +302,42 @@ void readClonebaySystem(
 void readOxygenSystem(OxygenSystem& oxygen, const raw::OxygenSystem& raw)
 {
 	readSystem(oxygen, raw);
-	oxygen.blueprint = Reader::getState().blueprints.systemBlueprints.at("oxygen");
 
 	// nothing else interesting?
 }
 
 // Read teleporter info that is shared on both player and enemy ships
+// Needs the rooms to already have their crew
 void readTeleporterSystemGeneric(
 	TeleporterSystem& teleporter,
 	const raw::TeleportSystem& raw,
-	std::vector<Crew>& crew)
+	const std::vector<Room>& rooms)
 {
 	readSystem(teleporter, raw);
-	teleporter.blueprint = Reader::getState().blueprints.systemBlueprints.at("teleporter");
 
 	teleporter.slots = raw.iNumSlots;
 	teleporter.crewPresent.clear();
 
-	for (size_t i = 0; i < crew.size(); i++)
+	if (teleporter.room >= 0 && size_t(teleporter.room) < rooms.size())
 	{
-		if (teleporter.room == crew[i].room && !crew[i].moving)
-			teleporter.crewPresent.push_back(&crew[i]);
+		auto&& room = rooms[teleporter.room];
+		bool player = raw._shipObj.iShipId == 0;
+
+		// The ship's own crew could be intruders if they're mind controlled
+		for (auto* list : { &room.crew, &room.intruders })
+		{
+			for (auto* c : *list)
+			{
+				if (c->player == player && !c->moving)
+					teleporter.crewPresent.push_back(c);
+			}
+		}
 	}
 
 	teleporter.canSend = raw.bCanSend;
 	teleporter.canReceive = raw.bCanReceive;
 }
 
-void readBlueprint(Blueprint& blueprint, const raw::Blueprint& raw)
-{
-	blueprint.name = raw.name.str;
-	blueprint.cost = raw.desc.cost;
-	blueprint.rarity = raw.desc.rarity;
-	blueprint.baseRarity = raw.desc.baseRarity;
-}
 
 void readAugment(Augment& augment, const raw::AugmentBlueprint& raw)
 {
@@ -285,7 +413,7 @@ void readWeaponBlueprint(WeaponBlueprint& blueprint, const raw::WeaponBlueprint&
 
 void readWeapon(Weapon& weapon, const raw::ProjectileFactory& raw, const Point<int>& offset)
 {
-	readWeaponBlueprint(weapon.blueprint, *raw.blueprint);
+	weapon.blueprint = findBlueprint(Reader::getState().blueprints.weaponBlueprints, *raw.blueprint);
 	weapon.player = raw.iShipId == 0;
 
 	weapon.power.total.first = !raw.powered
@@ -320,7 +448,7 @@ void readWeapon(Weapon& weapon, const raw::ProjectileFactory& raw, const Point<i
 	weapon.hackLevel = HackLevel(raw.iHackLevel);
 
 	weapon.boost.first = raw.boostLevel;
-	weapon.boost.second = weapon.blueprint.boost.count;
+	weapon.boost.second = weapon.blueprint->boost.count;
 	weapon.charge.first = raw.chargeLevel;
 	weapon.charge.second = raw.goalChargeLevel;
 
@@ -437,7 +565,7 @@ void readDrone(
 	const Point<int>& enemyShipPos,
 	int superShieldBubbles = 0)
 {
-	readDroneBlueprint(drone.blueprint, *raw.blueprint);
+	drone.blueprint = findBlueprint(Reader::getState().blueprints.droneBlueprints, *raw.blueprint);
 
 	drone.player = raw.iShipId == 0;
 
@@ -467,7 +595,7 @@ void readDrone(
 	drone.powerUpTimer = { 0.f, 0.f };
 	drone.powerDownTimer = { 0.f, 0.f };
 
-	auto&& type = drone.blueprint.type;
+	auto&& type = drone.blueprint->type;
 
 	if (drone.crewDrone())
 	{
@@ -529,7 +657,7 @@ void readDrone(
 		}
 		else
 		{
-			info.cooldown.second = drone.blueprint.cooldown;
+			info.cooldown.second = drone.blueprint->cooldown;
 		}
 
 		info.angle = casted.aimingAngle;
@@ -537,15 +665,9 @@ void readDrone(
 		info.angleMalfunction = casted.hackAngle;
 		info.ionTime = casted.ionStun;
 
-		if (casted.weaponBlueprint)
-		{
-			info.weapon.emplace();
-			readWeaponBlueprint(*info.weapon, *casted.weaponBlueprint);
-		}
-		else
-		{
-			info.weapon.reset();
-		}
+		info.weapon = casted.weaponBlueprint
+			? findBlueprint(Reader::getState().blueprints.weaponBlueprints, *casted.weaponBlueprint)
+			: nullptr;
 
 		// This is weird in that it's -1 if the weapon's not on cooldown
 		// Then it decreases to 0
@@ -600,18 +722,37 @@ void readSystemBlueprint(SystemBlueprint& blueprint, const raw::SystemBlueprint&
 	}
 }
 
+void readRuntimeBlueprint(WeaponBlueprint& blueprint, const raw::Blueprint& raw)
+{
+	readWeaponBlueprint(blueprint, static_cast<const raw::WeaponBlueprint&>(raw));
+}
+
+void readRuntimeBlueprint(DroneBlueprint& blueprint, const raw::Blueprint& raw)
+{
+	readDroneBlueprint(blueprint, static_cast<const raw::DroneBlueprint&>(raw));
+}
+
+void readRuntimeBlueprint(Augment& blueprint, const raw::Blueprint& raw)
+{
+	readAugment(blueprint, static_cast<const raw::AugmentBlueprint&>(raw));
+}
+
+void readRuntimeBlueprint(SystemBlueprint& blueprint, const raw::Blueprint& raw)
+{
+	readSystemBlueprint(blueprint, static_cast<const raw::SystemBlueprint&>(raw));
+}
+
 void readWeaponSystem(WeaponSystem& weapons, const raw::WeaponSystem& raw, const Point<int>& offset)
 {
 	readSystem(weapons, raw);
-	weapons.blueprint = Reader::getState().blueprints.systemBlueprints.at("weapons");
 
-	weapons.list.clear();
+	recycleList(weapons.list, raw.weapons.size());
 	weapons.autoFire = false; // set when reading player ship
 	weapons.slotCount = false; // set when reading ship
 
 	for (size_t i = 0; i < raw.weapons.size(); i++)
 	{
-		auto& weapon = weapons.list.emplace_back();
+		auto& weapon = weapons.list[i];
 		readWeapon(weapon, *raw.weapons[i], offset);
 		weapon.slot = int(i);
 		weapon.power.ionLevel = weapons.power.ionLevel;
@@ -647,14 +788,13 @@ void readDroneSystem(
 	int superShieldBubbles = 0)
 {
 	readSystem(drones, raw);
-	drones.blueprint = Reader::getState().blueprints.systemBlueprints.at("drones");
 
-	drones.list.clear();
+	recycleList(drones.list, raw.drones.size());
 	drones.slotCount = false; // set when reading ship
 
 	for (size_t i = 0; i < raw.drones.size(); i++)
 	{
-		auto& drone = drones.list.emplace_back();
+		auto& drone = drones.list[i];
 		readDrone(drone, *raw.drones[i], playerShipPos, enemyShipPos, superShieldBubbles);
 		drone.slot = int(i);
 		drone.power.ionLevel = drones.power.ionLevel;
@@ -685,7 +825,6 @@ void readDroneSystem(
 void readCloakingSystem(CloakingSystem& cloaking, const raw::CloakingSystem& raw)
 {
 	readSystem(cloaking, raw);
-	cloaking.blueprint = Reader::getState().blueprints.systemBlueprints.at("cloaking");
 
 	cloaking.on = raw.bTurnedOn;
 	cloaking.timer.first = raw.timer.currGoal - raw.timer.currTime;
@@ -699,7 +838,6 @@ void readCloakingSystem(CloakingSystem& cloaking, const raw::CloakingSystem& raw
 void readPilotingSystem(PilotingSystem& piloting, const raw::ShipSystem& raw)
 {
 	readSystem(piloting, raw);
-	piloting.blueprint = Reader::getState().blueprints.systemBlueprints.at("pilot");
 
 	// Probably no extra fields?
 }
@@ -707,7 +845,6 @@ void readPilotingSystem(PilotingSystem& piloting, const raw::ShipSystem& raw)
 void readSensorsSystem(SensorSystem& sensors, const raw::ShipSystem& raw)
 {
 	readSystem(sensors, raw);
-	sensors.blueprint = Reader::getState().blueprints.systemBlueprints.at("sensors");
 
 	// Probably no extra fields?
 }
@@ -715,7 +852,6 @@ void readSensorsSystem(SensorSystem& sensors, const raw::ShipSystem& raw)
 void readDoorSystem(DoorSystem& doors, const raw::ShipSystem& raw)
 {
 	readSystem(doors, raw);
-	doors.blueprint = Reader::getState().blueprints.systemBlueprints.at("doors");
 
 	// Probably no extra fields?
 }
@@ -723,7 +859,6 @@ void readDoorSystem(DoorSystem& doors, const raw::ShipSystem& raw)
 void readArtillerySystem(ArtillerySystem& artillery, const raw::ArtillerySystem& raw, const Point<int>& offset)
 {
 	readSystem(artillery, raw);
-	artillery.blueprint = Reader::getState().blueprints.systemBlueprints.at("artillery");
 
 	if (raw.projectileFactory)
 	{
@@ -734,7 +869,6 @@ void readArtillerySystem(ArtillerySystem& artillery, const raw::ArtillerySystem&
 void readBatterySystem(BatterySystem& battery, const raw::BatterySystem& raw)
 {
 	readSystem(battery, raw);
-	battery.blueprint = Reader::getState().blueprints.systemBlueprints.at("battery");
 
 	battery.on = raw.bTurnedOn;
 
@@ -752,7 +886,6 @@ void readBatterySystem(BatterySystem& battery, const raw::BatterySystem& raw)
 void readMindControlSystem(MindControlSystem& mindControl, const raw::MindSystem& raw)
 {
 	readSystem(mindControl, raw);
-	mindControl.blueprint = Reader::getState().blueprints.systemBlueprints.at("mind");
 
 	mindControl.on = raw.controlTimer.first < raw.controlTimer.second;
 
@@ -775,7 +908,6 @@ void readHackingSystem(
 	const Point<int>& enemyShipPos)
 {
 	readSystem(hacking, raw);
-	hacking.blueprint = Reader::getState().blueprints.systemBlueprints.at("hacking");
 
 	readDrone(hacking.drone, raw.drone, playerShipPos, enemyShipPos);
 
@@ -840,12 +972,8 @@ int calculateEvasion(
 	return result;
 }
 
-void readRoom(
-	Room& room,
-	std::vector<Crew>& crew,
-	std::vector<Crew>& enemyCrew,
-	const raw::Room& raw,
-	const Point<int>& offset)
+// Crew are added to rooms afterwards by placeCrew
+void readRoom(Room& room, const raw::Room& raw, const Point<int>& offset)
 {
 	room.player = raw.iShipId == 0;
 	room.id = raw.iRoomId;
@@ -870,34 +998,70 @@ void readRoom(
 
 	room.crew.clear();
 	room.intruders.clear();
+}
 
-	// Crew
-	auto iterate = [&](auto& v) {
-		for (auto&& c : v)
-		{
-			if (c.room != room.id) continue;
+// Things on a ship grouped by the room they're in
+// Built in one pass so each room only has to look at its own things
+template<typename T>
+class RoomBuckets
+{
+public:
+	RoomBuckets(size_t rooms, std::pmr::memory_resource* resource)
+		: offsets(rooms + 1, 0, resource)
+		, next(resource)
+		, items(resource)
+	{}
 
-			if (c.intruder)
-			{
-				room.intruders.push_back(&c);
-			}
-			else
-			{
-				room.crew.push_back(&c);
-			}
+	// Everything gets counted, then allocated for, then placed
+	void count(const T& item)
+	{
+		if (this->valid(item)) this->offsets[item.roomId + 1]++;
+	}
+
+	void allocate()
+	{
+		for (size_t i = 1; i < this->offsets.size(); i++)
+		{
+			this->offsets[i] += this->offsets[i - 1];
 		}
-	};
 
-	iterate(crew);
-	iterate(enemyCrew);
-}
+		this->items.resize(this->offsets.back(), nullptr);
+		this->next.assign(this->offsets.begin(), this->offsets.end() - 1);
+	}
+
+	void place(const T& item)
+	{
+		if (this->valid(item)) this->items[this->next[item.roomId]++] = &item;
+	}
+
+	std::span<const T* const> operator[](int room) const
+	{
+		if (room < 0 || size_t(room) + 1 >= this->offsets.size()) return {};
+
+		return std::span<const T* const>(
+			this->items.data() + this->offsets[room],
+			this->offsets[room + 1] - this->offsets[room]);
+	}
+
+private:
+	bool valid(const T& item) const
+	{
+		return
+			item.fDamage > 0.f &&
+			item.roomId >= 0 &&
+			size_t(item.roomId) + 1 < this->offsets.size();
+	}
+
+	std::pmr::vector<size_t> offsets, next;
+	std::pmr::vector<const T*> items;
+};
 
 // Only call after room is read
 void readRoomSlots(
 	Room& room,
 	const raw::Room& raw,
-	const raw::Spreader<raw::Fire>& fires,
-	const raw::gcc::vector<raw::OuterHull*>& hull,
+	std::span<const raw::Fire* const> fires,
+	std::span<const raw::OuterHull* const> breaches,
 	const Point<int>& offset)
 {
 	int slotCount = room.tiles.x * room.tiles.y;
@@ -937,54 +1101,28 @@ void readRoomSlots(
 		slot.rect.y = room.rect.y + slot.position.y * Room::HARDCODED_TILE_SIZE;
 		slot.rect.w = Room::HARDCODED_TILE_SIZE;
 		slot.rect.h = Room::HARDCODED_TILE_SIZE;
-
-		// Crew
-		for (auto&& c : room.crew)
-		{
-			if (slot.rect.contains(c->position))
-			{
-				c->slot = slot.id;
-				if(!c->moving) slot.crew = c;
-			}
-		}
-
-		for (auto&& c : room.intruders)
-		{
-			if (slot.rect.contains(c->position))
-			{
-				c->slot = slot.id;
-				if (!c->moving) slot.intruder = c;
-			}
-		}
 	}
 
 	// Fires
-	for (size_t xt = 0; xt < fires.grid.size(); xt++)
+	for (auto* fire : fires)
 	{
-		auto&& row = fires.grid[xt];
-
-		for (size_t yt = 0; yt < row.size(); yt++)
-		{
-			auto&& cell = row[yt];
-			if (cell.fDamage <= 0.f || cell.roomId != room.id) continue;
-			auto&& slot = room.slotAt(offset + Point<int>{ cell.pLoc.x, cell.pLoc.y });
+		auto&& cell = *fire;
+		auto&& slot = room.slotAt(offset + Point<int>{ cell.pLoc.x, cell.pLoc.y });
 
-			room.fireRepair += cell.fDamage / 100.f;
+		room.fireRepair += cell.fDamage / 100.f;
 
-			slot.fire = Fire{};
-			slot.fire->repairProgress = (100.f - cell.fDamage) / 100.f;
-			slot.fire->position = offset + Point<int>{cell.pLoc.x, cell.pLoc.y};
-			slot.fire->room = cell.roomId;
-			slot.fire->slot = slot.id;
-			slot.fire->deathTimer = cell.fDeathTimer;
-		}
+		slot.fire = Fire{};
+		slot.fire->repairProgress = (100.f - cell.fDamage) / 100.f;
+		slot.fire->position = offset + Point<int>{cell.pLoc.x, cell.pLoc.y};
+		slot.fire->room = cell.roomId;
+		slot.fire->slot = slot.id;
+		slot.fire->deathTimer = cell.fDeathTimer;
 	}
 
 	// Breaches
-	for (size_t i = 0; i < hull.size(); i++)
+	for (auto* breach : breaches)
 	{
-		auto&& cell = *hull[i];
-		if (cell.fDamage <= 0.f || cell.roomId != room.id) continue;
+		auto&& cell = *breach;
 		auto&& slot = room.slotAt(offset + Point<int>{ cell.pLoc.x, cell.pLoc.y });
 
 		room.breachRepair += cell.fDamage / 100.f;
@@ -997,6 +1135,50 @@ void readRoomSlots(
 	}
 }
 
+// Gets the slot a position is in from the tile grid, or -1 if it's not in the room
+// Like Rect::contains, positions on the edge between two slots go to the later one
+int slotIdContaining(const Room& room, const Point<int>& position)
+{
+	int x = position.x - room.rect.x;
+	int y = position.y - room.rect.y;
+
+	if (room.slots.empty() || x < 0 || y < 0 || x > room.rect.w || y > room.rect.h) return -1;
+
+	x = std::min(x / Room::HARDCODED_TILE_SIZE, room.tiles.x - 1);
+	y = std::min(y / Room::HARDCODED_TILE_SIZE, room.tiles.y - 1);
+
+	return x + y * room.tiles.x;
+}
+
+// Puts the crew that are on the ship into their rooms & slots
+// Only call after the rooms & slots are read
+void placeCrew(Ship& ship, std::vector<Crew>& crew)
+{
+	for (auto&& c : crew)
+	{
+		if (c.onPlayerShip != ship.player) continue;
+		if (c.room < 0 || size_t(c.room) >= ship.rooms.size()) continue;
+
+		// Room ids match their index
+		auto&& room = ship.rooms[c.room];
+
+		if (c.intruder) room.intruders.push_back(&c);
+		else room.crew.push_back(&c);
+
+		int id = slotIdContaining(room, c.position);
+		if (id < 0) continue;
+
+		auto&& slot = room.slots[id];
+		c.slot = id;
+
+		if (!c.moving)
+		{
+			if (c.intruder) slot.intruder = &c;
+			else slot.crew = &c;
+		}
+	}
+}
+
 void readDoor(
 	Door& door,
 	const raw::Door& raw,
@@ -1086,16 +1268,44 @@ void readGenericShipStuff(
 	ship.totalOxygen = 0.f;
 
 	// Room stuffs
-	ship.rooms.clear();
-	for (size_t i = 0; i < raw.ship.vRoomList.size(); i++)
+	// Fires & breaches are sorted into rooms first, rather than every room going through all of them
+	size_t roomCount = raw.ship.vRoomList.size();
+	ScratchArena<4096> scratch;
+	RoomBuckets<raw::Fire> fires(roomCount, &scratch.resource);
+	RoomBuckets<raw::OuterHull> breaches(roomCount, &scratch.resource);
+
+	auto&& fireGrid = raw.fireSpreader.grid;
+	auto&& hull = raw.ship.vOuterWalls;
+
+	for (size_t xt = 0; xt < fireGrid.size(); xt++)
 	{
-		auto&& room = ship.rooms.emplace_back();
+		for (size_t yt = 0; yt < fireGrid[xt].size(); yt++) fires.count(fireGrid[xt][yt]);
+	}
+
+	fires.allocate();
+
+	for (size_t xt = 0; xt < fireGrid.size(); xt++)
+	{
+		for (size_t yt = 0; yt < fireGrid[xt].size(); yt++) fires.place(fireGrid[xt][yt]);
+	}
+
+	for (size_t i = 0; i < hull.size(); i++) breaches.count(*hull[i]);
+	breaches.allocate();
+	for (size_t i = 0; i < hull.size(); i++) breaches.place(*hull[i]);
+
+	recycleList(ship.rooms, roomCount);
+	for (size_t i = 0; i < roomCount; i++)
+	{
+		auto&& room = ship.rooms[i];
 		auto&& rawRoom = *raw.ship.vRoomList[i];
 
-		readRoom(room, crew, enemyCrew, rawRoom, position);
-		readRoomSlots(room, rawRoom, raw.fireSpreader, raw.ship.vOuterWalls, position);
+		readRoom(room, rawRoom, position);
+		readRoomSlots(room, rawRoom, fires[room.id], breaches[room.id], position);
 	}
 
+	placeCrew(ship, crew);
+	placeCrew(ship, enemyCrew);
+
 	// Doors
 	ship.doors.clear();
 	for (size_t i = 0; i < raw.ship.vDoorList.size(); i++)
@@ -1110,6 +1320,17 @@ void readGenericShipStuff(
 		readDoor(ship.doors.emplace_back(), *raw.ship.vOuterAirlocks[i], position, true, begin+i);
 	}
 
+	// Each ship gets its own copy of the graph, since blocked doors are per ship
+	// A different ship gets a fresh copy even with the same layout, so blocked doors don't carry over
+	bool newShip = ship._rawPtr != &raw;
+	ship._rawPtr = &raw;
+
+	if (newShip || !ship.graph || !ship.graph->matches(ship.rooms, ship.doors))
+	{
+		auto layout = ShipGraph::layoutOf(ship.rooms, ship.doors);
+		ship.graph = std::make_shared<ShipGraph>(*ShipGraph::cached(layout));
+	}
+
 	auto&& sysBoxes = Reader::getRawState().app->gui->sysControl.sysBoxes;
 
 	// Read systems
@@ -1185,7 +1406,7 @@ void readGenericShipStuff(
 			readTeleporterSystemGeneric(
 				*ship.teleporter, 
 				*static_cast<raw::TeleportSystem*>(current),
-				crew);
+				ship.rooms);
 			if (ship.player) ship.teleporter->uiBox = int(i);
 			break;
 		case SystemType::Cloaking:
@@ -1486,10 +1707,9 @@ void readCrewList(
 {
 	constexpr bool player = std::same_as<T, raw::CrewBox>;
 
-	crew.clear();
-
-	std::unordered_map<raw::CrewMember*, size_t> selectionIndices;
-	std::vector<raw::CrewMember*> ptrs;
+	ScratchArena<2048> scratch;
+	std::pmr::unordered_map<raw::CrewMember*, size_t> selectionIndices(&scratch.resource);
+	std::pmr::vector<raw::CrewMember*> ptrs(&scratch.resource);
 
 	if constexpr (player) // use crew boxes so they're sorted by ui box
 	{
@@ -1530,24 +1750,26 @@ void readCrewList(
 		}
 	}
 
+	recycleList(crew, ptrs.size());
+
 	for (size_t i = 0; i < ptrs.size(); i++)
 	{
 		Point<int> offset = ptrs[i]->currentShipId == 0 // on player ship
 			? playerShipPos
 			: enemyShipPos;
 
-		readCrew(crew.emplace_back(), *ptrs[i], offset);
+		readCrew(crew[i], *ptrs[i], offset);
 		if constexpr (player)
 		{
-			crew.back().id = int(i);
+			crew[i].id = int(i);
 			auto it = selectionIndices.find(ptrs[i]);
-			crew.back().selectionId = it != selectionIndices.end() ? it->second : -1;
+			crew[i].selectionId = it != selectionIndices.end() ? int(it->second) : -1;
 		}
 
 		if (arriving && leaving)
 		{
 			readCrewTeleportInfo(
-				crew.back(),
+				crew[i],
 				ptrs[i],
 				*arriving, *leaving
 			);
@@ -1732,52 +1954,39 @@ void readStore(Store& store, const raw::Store& raw)
 
 		if (&rawBox == raw.confirmBuy) store.confirming = &box;
 
+		auto&& blueprints = Reader::getState().blueprints;
+
 		switch (box.type)
 		{
 		case StoreBoxType::Weapon:
-		{
-			WeaponBlueprint item;
-			readWeaponBlueprint(item, static_cast<const raw::WeaponBlueprint&>(*rawBox.pBlueprint));
-			box.item = item;
+			box.item = findBlueprint(blueprints.weaponBlueprints, *rawBox.pBlueprint);
 			break;
-		}
 		case StoreBoxType::Drone:
-		{
-			DroneBlueprint item;
-			readDroneBlueprint(item, static_cast<const raw::DroneBlueprint&>(*rawBox.pBlueprint));
-			box.item = item;
+			box.item = findBlueprint(blueprints.droneBlueprints, *rawBox.pBlueprint);
 			break;
-		}
 		case StoreBoxType::Augment:
-		{
-			Augment item;
-			readAugment(item, static_cast<const raw::AugmentBlueprint&>(*rawBox.pBlueprint));
-			box.item = item;
+			box.item = findBlueprint(blueprints.augmentBlueprints, *rawBox.pBlueprint);
 			break;
-		}
 		case StoreBoxType::Crew:
 		{
 			CrewBlueprint item;
 			readCrewBlueprint(item, static_cast<const raw::CrewBlueprint&>(*rawBox.pBlueprint));
-			box.item = item;
+			box.item = std::move(item);
 			break;
 		}
 		case StoreBoxType::System:
 		{
 			auto&& casted = static_cast<const raw::SystemStoreBox&>(rawBox);
-			SystemBlueprint item;
-			readSystemBlueprint(item, static_cast<const raw::SystemBlueprint&>(*rawBox.pBlueprint));
-			box.item = item;
+			box.item = findBlueprint(blueprints.systemBlueprints, *rawBox.pBlueprint);
 
 			// Check for free drone
 			if (SystemType(casted.type) == SystemType::Drones)
 			{
-				auto&& blueprints = Reader::getState().blueprints.droneBlueprints;
-				auto it = blueprints.find(casted.freeBlueprint.str);
+				auto it = blueprints.droneBlueprints.find(casted.freeBlueprint.str);
 
-				if (it != blueprints.end())
+				if (it != blueprints.droneBlueprints.end())
 				{
-					box.extra = it->second;
+					box.extra = &it->second;
 				}
 			}
 
@@ -1842,10 +2051,13 @@ void readResourceEvent(ResourceEvent& event, const raw::ResourceEvent& raw)
 // This is just for the edge case where you cheat in a store event
 // and then cheat in another event that removes the store from the current event
 // but the store still exists and needs accessing somehow!
-void readLocationEvent(LocationEvent& event, const raw::LocationEvent& raw, bool preserveStore = false)
+std::shared_ptr<LocationEvent> internLocationEvent(EventCache& cache, const raw::LocationEvent& raw);
+
+void readLocationEvent(LocationEvent& event, const raw::LocationEvent& raw, EventCache& cache, bool preserveStore = false)
 {
 	if (!preserveStore) event._storePtr = nullptr;
 
+	event._rawPtr = &raw;
 	event.environment = EnvironmentType(raw.environment);
 	event.environmentTargetsEnemy = raw.environmentTarget == 1;
 	event.exit = raw.beacon;
@@ -1908,16 +2120,95 @@ void readLocationEvent(LocationEvent& event, const raw::LocationEvent& raw, bool
 		// as circular events crash it upon loading
 		if (rawChoice.event)
 		{
-			choice.event = std::make_shared<LocationEvent>();
-			readLocationEvent(*choice.event, *rawChoice.event);
+			choice.event = internLocationEvent(cache, *rawChoice.event);
 		}
 	
 		choice.blue = rawChoice.requirement.blue;
 	}
 }
 
+// Gets the already read event for a raw event, reading it if needed
+std::shared_ptr<LocationEvent> internLocationEvent(EventCache& cache, const raw::LocationEvent& raw)
+{
+	auto it = cache.find(&raw);
+	if (it != cache.end()) return it->second;
+
+	auto event = std::make_shared<LocationEvent>();
+	cache.emplace(&raw, event);
+	readLocationEvent(*event, raw, cache);
+	return event;
+}
+
+template<typename Set>
+void collectEvents(const raw::LocationEvent* raw, Set& reached)
+{
+	if (!raw || !reached.insert(raw).second) return;
+
+	for (size_t i = 0; i < raw->choices.size(); i++)
+	{
+		collectEvents(raw->choices[i].event, reached);
+	}
+}
+
+// Drops the cached events that can't be reached from the base event or the map anymore,
+// since the game may have freed them, then refreshes the stores of the rest
+// Stores are the only part of an event that changes after it's generated
+void refreshEventCache(EventCache& cache, const raw::LocationEvent* base, const raw::StarMap& map)
+{
+	ScratchArena<8192> scratch;
+	std::pmr::unordered_set<const raw::LocationEvent*> reached(&scratch.resource);
+
+	collectEvents(base, reached);
+
+	for (size_t i = 0; i < map.locations.size(); i++)
+	{
+		collectEvents(map.locations[i]->event, reached);
+	}
+
+	for (auto it = cache.begin(); it != cache.end();)
+	{
+		if (!reached.count(it->first))
+		{
+			it = cache.erase(it);
+			continue;
+		}
+
+		auto&& [raw, event] = *it++;
+
+		if (raw->pStore)
+		{
+			event->_storePtr = raw->pStore;
+			if (!event->store) event->store.emplace();
+			readStore(*event->store, *raw->pStore);
+		}
+	}
+}
+
+// Like readLocationEvent, but only re-reads the event if it's a different one
+// The choices are shared through the cache, so only the store needs refreshing
+void updateLocationEvent(LocationEvent& event, const raw::LocationEvent& raw, EventCache& cache)
+{
+	if (event._rawPtr != &raw)
+	{
+		readLocationEvent(event, raw, cache);
+		return;
+	}
+
+	if (raw.pStore)
+	{
+		event._storePtr = raw.pStore;
+		if (!event.store) event.store.emplace();
+		readStore(*event.store, *raw.pStore);
+	}
+	else if (event._storePtr)
+	{
+		event._storePtr = nullptr;
+		event.store.reset();
+	}
+}
+
 // id & neighbors are read in the readStarMap function
-void readLocation(Location& location, const raw::Location& raw, const Point<int>& offset)
+void readLocation(Location& location, const raw::Location& raw, const Point<int>& offset, EventCache& cache)
 {
 	location.hitbox.x = int(raw.loc.x) + offset.x - Location::HARDCODED_SIZE/2;
 	location.hitbox.y = int(raw.loc.y) + offset.y - Location::HARDCODED_SIZE/2;
@@ -1933,7 +2224,9 @@ void readLocation(Location& location, const raw::Location& raw, const Point<int>
 	location.quest = raw.questLoc;
 	location.fleetOvertaking = raw.fleetChanging;
 	location.enemyShip = raw.event && raw.event->ship.present && raw.event->ship.hostile;
-	if(raw.event) readLocationEvent(location.event, *raw.event);
+
+	if (raw.event) updateLocationEvent(location.event, *raw.event, cache);
+	else if (location.event._rawPtr) location.event = LocationEvent{};
 }
 
 // id & neighbors are read in the readStarMap function
@@ -1952,8 +2245,55 @@ void readSector(Sector& sector, const raw::Sector& raw, const Point<int>& offset
 	sector.unique = raw.description.unique;
 }
 
-void readStarMap(StarMap& map, const raw::StarMap& raw)
+// Checks if the locations or sectors still match the raw ones one to one,
+// neighbors included, so that the existing objects can be updated in place
+template<typename T, typename Raw, typename F>
+bool sameLayout(const std::vector<T>& list, const raw::gcc::vector<Raw*>& raw, F&& rawNeighbors)
+{
+	if (list.size() != raw.size()) return false;
+
+	for (size_t i = 0; i < raw.size(); i++)
+	{
+		auto&& neighbors = list[i].neighbors;
+		auto&& rawList = rawNeighbors(*raw[i]);
+
+		if (list[i]._rawPtr != raw[i]) return false;
+		if (neighbors.size() != rawList.size()) return false;
+
+		for (size_t j = 0; j < rawList.size(); j++)
+		{
+			if (neighbors[j]->_rawPtr != rawList[j]) return false;
+		}
+	}
+
+	return true;
+}
+
+template<typename T, typename Raw>
+T* findByRaw(std::vector<T>& list, const Raw* raw)
 {
+	if (!raw) return nullptr;
+
+	for (auto&& x : list)
+	{
+		if (x._rawPtr == raw) return &x;
+	}
+
+	return nullptr;
+}
+
+bool sectorChanged(const StarMap& map, const raw::StarMap& raw)
+{
+	return map.sectorNumber != raw.worldLevel || map._sectorPtr != raw.currentSector;
+}
+
+// The map only changes in structure when a new sector is generated,
+// so the locations & sectors are kept between frames unless that happens.
+// This keeps neighbor pointers stable and lets event trees be updated incrementally
+void readStarMap(StarMap& map, const raw::StarMap& raw, EventCache& events)
+{
+	bool newSector = sectorChanged(map, raw);
+
 	map.lastStand = raw.bossLevel;
 	map.flagshipJumping = raw.bossJumping;
 	map.mapRevealed = raw.bMapRevealed;
@@ -1968,93 +2308,165 @@ void readStarMap(StarMap& map, const raw::StarMap& raw)
 	map.nebulaSector = raw.bNebulaMap;
 	map.distressBeacon = raw.distressAnim.running;
 	map.sectorNumber = raw.worldLevel;
+	map._sectorPtr = raw.currentSector;
 
-	map.locations.clear();
-	map.flagshipPath.clear();
-	map.sectors.clear();
+	auto offset = raw.position + raw.translation;
 
-	std::unordered_map<raw::Location*, size_t> locIndex;
-	std::unordered_map<raw::Sector*, size_t> secIndex;
+	bool sameLocations = !newSector && sameLayout(
+		map.locations, raw.locations,
+		[](const raw::Location& loc) -> auto&& { return loc.connectedLocations; });
 
-	// read locations
-	for (size_t i = 0; i < raw.locations.size(); i++)
+	if (sameLocations)
 	{
-		auto offset = raw.position + raw.translation;
-		readLocation(map.locations.emplace_back(), *raw.locations[i], offset);
-		map.locations.back().id = int(i);
-		locIndex[raw.locations[i]] = i;
+		for (size_t i = 0; i < raw.locations.size(); i++)
+		{
+			readLocation(map.locations[i], *raw.locations[i], offset, events);
+		}
 	}
-
-	// read location neighbors
-	for (size_t i = 0; i < raw.locations.size(); i++)
+	else
 	{
-		auto&& loc = *raw.locations[i];
+		map.locations.clear();
+
+		ScratchArena<2048> scratch;
+		std::pmr::unordered_map<raw::Location*, size_t> locIndex(&scratch.resource);
 
-		for (size_t j = 0; j < loc.connectedLocations.size(); j++)
+		// read locations
+		for (size_t i = 0; i < raw.locations.size(); i++)
 		{
-			size_t idx = locIndex.at(loc.connectedLocations[j]);
-			map.locations[i].neighbors.push_back(&map.locations[idx]);
+			auto&& loc = map.locations.emplace_back();
+			readLocation(loc, *raw.locations[i], offset, events);
+			loc.id = int(i);
+			loc._rawPtr = raw.locations[i];
+			locIndex[raw.locations[i]] = i;
+		}
+
+		// read location neighbors
+		for (size_t i = 0; i < raw.locations.size(); i++)
+		{
+			auto&& loc = *raw.locations[i];
+
+			for (size_t j = 0; j < loc.connectedLocations.size(); j++)
+			{
+				size_t idx = locIndex.at(loc.connectedLocations[j]);
+				map.locations[i].neighbors.push_back(&map.locations[idx]);
+			}
 		}
 	}
 
 	// read flagship path
+	map.flagshipPath.clear();
+
 	for (size_t i = 0; i < raw.boss_path.size(); i++)
 	{
-		auto&& loc = *raw.boss_path[i];
-		size_t idx = locIndex.at(raw.boss_path[i]);
-		map.flagshipPath.push_back(&map.locations[idx]);
+		auto* loc = findByRaw(map.locations, raw.boss_path[i]);
+		if (!loc) throw std::out_of_range("flagship path location not on the map");
+		map.flagshipPath.push_back(loc);
 	}
 
 	// read current location
+	map.currentLocation = findByRaw(map.locations, raw.currentLoc);
+
+	bool sameSectors = sameLayout(
+		map.sectors, raw.sectors,
+		[](const raw::Sector& sec) -> auto&& { return sec.neighbors; });
+
+	if (sameSectors)
 	{
-		auto it = locIndex.find(raw.currentLoc);
+		for (size_t i = 0; i < raw.sectors.size(); i++)
+		{
+			readSector(map.sectors[i], *raw.sectors[i], raw.sectorMapOffset);
+		}
+	}
+	else
+	{
+		map.sectors.clear();
 
-		if (it == locIndex.end())
+		ScratchArena<1024> scratch;
+		std::pmr::unordered_map<raw::Sector*, size_t> secIndex(&scratch.resource);
+
+		// read sectors
+		for (size_t i = 0; i < raw.sectors.size(); i++)
 		{
-			map.currentLocation = nullptr;
+			auto&& sec = map.sectors.emplace_back();
+			readSector(sec, *raw.sectors[i], raw.sectorMapOffset);
+			sec.id = int(i);
+			sec._rawPtr = raw.sectors[i];
+			secIndex[raw.sectors[i]] = i;
 		}
-		else
+
+		// read sector neighbors
+		for (size_t i = 0; i < raw.sectors.size(); i++)
 		{
-			size_t idx = it->second;
-			map.currentLocation = &map.locations[idx];
+			auto&& sec = *raw.sectors[i];
+
+			for (size_t j = 0; j < sec.neighbors.size(); j++)
+			{
+				size_t idx = secIndex.at(sec.neighbors[j]);
+				map.sectors[i].neighbors.push_back(&map.sectors[idx]);
+			}
 		}
 	}
 
-	// read sectors
-	for (size_t i = 0; i < raw.sectors.size(); i++)
-	{
-		readSector(map.sectors.emplace_back(), *raw.sectors[i], raw.sectorMapOffset);
-		map.sectors.back().id = int(i);
-		secIndex[raw.sectors[i]] = i;
-	}
+	// read current sector
+	map.currentSector = findByRaw(map.sectors, raw.currentSector);
+}
 
-	// read sector neighbors
-	for (size_t i = 0; i < raw.sectors.size(); i++)
-	{
-		auto&& sec = *raw.sectors[i];
+bool hotkeysChanged(const std::vector<int>& last, const raw::SettingValues& raw)
+{
+	size_t count = 0;
+	for (auto&& page : raw.hotkeys) count += page.size();
+	if (count != last.size()) return true;
+
+	size_t i = 0;
 
-		for (size_t j = 0; j < sec.neighbors.size(); j++)
+	for (auto&& page : raw.hotkeys)
+	{
+		for (size_t j = 0; j < page.size(); j++)
 		{
-			size_t idx = secIndex.at(sec.neighbors[j]);
-			map.sectors[i].neighbors.push_back(&map.sectors[idx]);
+			if (page[j].key != last[i++]) return true;
 		}
 	}
 
-	// read current sector
+	return false;
+}
+
+template<size_t N>
+void readNumberedHotkeys(
+	std::array<HotkeyTable::Entry, N>& table,
+	const std::map<std::string, Key>& hotkeys,
+	const std::string& prefix)
+{
+	for (size_t i = 0; i < N; i++)
 	{
-		auto it = secIndex.find(raw.currentSector);
+		auto it = hotkeys.find(prefix + std::to_string(i + 1));
+		table[i] = it != hotkeys.end() ? HotkeyTable::Entry(it->second) : std::nullopt;
+	}
+}
 
-		if (it == secIndex.end())
-		{
-			map.currentSector = nullptr;
-		}
-		else
-		{
-			size_t idx = it->second;
-			map.currentSector = &map.sectors[idx];
-		}
+void readHotkeyTable(HotkeyTable& table, const std::map<std::string, Key>& hotkeys)
+{
+	auto find = [&](const std::string& name) -> HotkeyTable::Entry {
+		auto it = hotkeys.find(name);
+		if (it == hotkeys.end()) return std::nullopt;
+		return it->second;
+	};
 
+	for (size_t i = 0; i < table.named.size(); i++)
+	{
+		table.named[i] = find(hotkeyName(Hotkey(i)));
 	}
+
+	for (size_t i = 0; i < HotkeyTable::SYSTEMS; i++)
+	{
+		table.systemPower[i] = find(systemPowerHotkey(SystemType(i)));
+		table.systemUnpower[i] = find(systemUnpowerHotkey(SystemType(i)));
+	}
+
+	readNumberedHotkeys(table.power, hotkeys, "power_");
+	readNumberedHotkeys(table.unpower, hotkeys, "un_power_");
+	readNumberedHotkeys(table.crew, hotkeys, "crew");
+	readNumberedHotkeys(table.weapons, hotkeys, "weapon");
+	readNumberedHotkeys(table.drones, hotkeys, "drone");
 }
 
 void readSettings(Settings& settings, const raw::SettingValues& raw)
@@ -2077,7 +2489,11 @@ void readSettings(Settings& settings, const raw::SettingValues& raw)
 	settings.screenSize = raw.screenResolution;
 	settings.eventChoiceSelection = EventChoiceSelection(raw.dialogKeys);
 
+	// The hotkeys only change when the player rebinds them, so skip rebuilding if they're the same
+	if (!hotkeysChanged(settings._rawHotkeys, raw)) return;
+
 	settings.hotkeys.clear();
+	settings._rawHotkeys.clear();
 
 	for (size_t i = 0; i < raw.hotkeys.size(); i++)
 	{
@@ -2089,8 +2505,12 @@ void readSettings(Settings& settings, const raw::SettingValues& raw)
 				page[j].name.str,
 				Key(page[j].key)
 			);
+
+			settings._rawHotkeys.push_back(page[j].key);
 		}
 	}
+
+	readHotkeyTable(settings._hotkeyTable, settings.hotkeys);
 }
 
 void readUI(State& state, const raw::State& raw)
@@ -2723,12 +3143,15 @@ bool Reader::init()
 	rs.mouseControl = &mem::get<raw::MouseControl>(base + raw::MouseControlPtr);
 
 	// Read blueprints...
+	state.blueprints._byRaw.clear();
+	state.blueprints._runtime.clear();
 	state.blueprints.weaponBlueprints.clear();
 	rs.blueprints->weaponBlueprints.dfs([](const raw::gcc::string& key, const raw::WeaponBlueprint& value) {
 		std::string str = key.str;
 		auto&& [it, succ] = state.blueprints.weaponBlueprints.emplace(str, WeaponBlueprint{});
 		auto&& weapon = it->second;
 		readWeaponBlueprint(weapon, value);
+		state.blueprints._byRaw[&value] = &weapon;
 	});
 
 	state.blueprints.droneBlueprints.clear();
@@ -2737,6 +3160,7 @@ bool Reader::init()
 		auto&& [it, succ] = state.blueprints.droneBlueprints.emplace(str, DroneBlueprint{});
 		auto&& drone = it->second;
 		readDroneBlueprint(drone, value);
+		state.blueprints._byRaw[&value] = &drone;
 	});
 
 	state.blueprints.augmentBlueprints.clear();
@@ -2745,6 +3169,7 @@ bool Reader::init()
 		auto&& [it, succ] = state.blueprints.augmentBlueprints.emplace(str, Augment{});
 		auto&& aug = it->second;
 		readAugment(aug, value);
+		state.blueprints._byRaw[&value] = &aug;
 	});
 
 	state.blueprints.crewBlueprints.clear();
@@ -2761,8 +3186,25 @@ bool Reader::init()
 		auto&& [it, succ] = state.blueprints.systemBlueprints.emplace(str, SystemBlueprint{});
 		auto&& system = it->second;
 		readSystemBlueprint(system, value);
+		state.blueprints._byRaw[&value] = &system;
 	});
 
+	// The game's names for each system's blueprint
+	static const std::array<const char*, size_t(SystemType::Hacking) + 1> systemBlueprintNames{
+		"shields", "engines", "oxygen", "weapons", "drones", "medbay",
+		"pilot", "sensors", "doors", "teleporter", "cloaking", "artillery",
+		"battery", "clonebay", "mind", "hacking"
+	};
+
+	for (size_t i = 0; i < systemBlueprintNames.size(); i++)
+	{
+		auto it = state.blueprints.systemBlueprints.find(systemBlueprintNames[i]);
+
+		state.blueprints._systems[i] = it != state.blueprints.systemBlueprints.end()
+			? &it->second
+			: nullptr;
+	}
+
 	poll();
 
 	started = true;
@@ -2801,8 +3243,16 @@ void Reader::read()
 		game.pause.justPaused = !prevPause && game.pause.any;
 		game.pause.justUnpaused = prevPause && !game.pause.any;
 
+		bool prevGameOver = game.gameOver;
 		game.gameOver = rs.app->gui->gameover;
 
+		bool newRun = game.justLoaded || (prevGameOver && !game.gameOver);
+
+		// Runtime blueprints are only read once per read, and the ones from an old run are dropped
+		// This happens before the ships are read, since both of them look blueprints up
+		state.blueprints._generation++;
+		if (newRun) state.blueprints._runtime.clear();
+
 		Point<int> playerShipPos, enemyShipPos;
 		{
 			auto& playerPos = rs.app->gui->combatControl.playerShipPosition;
@@ -2819,16 +3269,13 @@ void Reader::read()
 			}
 		}
 
-		// Space stuffs
-		readSpace(game.space, rs.app->world->space, playerShipPos, enemyShipPos);
+		auto* playerCompleteShip = rs.app->world->playerShip;
+		auto* enemyCompleteShip = playerCompleteShip
+			? playerCompleteShip->enemyShip
+			: nullptr;
 
-		// Crew stuffs
+		// Space & crew stuffs
 		{
-			auto* playerCompleteShip = rs.app->world->playerShip;
-			auto* enemyCompleteShip = playerCompleteShip
-				? playerCompleteShip->enemyShip
-				: nullptr;
-
 			const raw::gcc::vector<raw::CrewMember*>
 				*playerArriving = nullptr, *playerLeaving = nullptr,
 				*enemyArriving = nullptr, *enemyLeaving = nullptr;
@@ -2845,73 +3292,85 @@ void Reader::read()
 				enemyLeaving = &enemyCompleteShip->leavingParty;
 			}
 
-			readCrewList(
-				game.playerCrew,
-				rs.app->gui->crewControl.crewBoxes,
-				playerShipPos, enemyShipPos,
-				playerArriving, playerLeaving,
-				&rs.app->gui->crewControl);
-
-			readCrewList(
-				game.enemyCrew,
-				rs.crewMemberFactory->crewMembers,
-				enemyShipPos, enemyShipPos,
-				enemyArriving, enemyLeaving);
+			runTasks({
+				[&] {
+					readSpace(game.space, rs.app->world->space, playerShipPos, enemyShipPos);
+				},
+				[&] {
+					readCrewList(
+						game.playerCrew,
+						rs.app->gui->crewControl.crewBoxes,
+						playerShipPos, enemyShipPos,
+						playerArriving, playerLeaving,
+						&rs.app->gui->crewControl);
+				},
+				[&] {
+					readCrewList(
+						game.enemyCrew,
+						rs.crewMemberFactory->crewMembers,
+						enemyShipPos, enemyShipPos,
+						enemyArriving, enemyLeaving);
+				}
+			});
 		}
 
+		// Ship stuffs, which need both crew lists
+		// Which ships exist is decided first, since the ships can look at each other
 		auto& shipStatus = rs.app->gui->shipStatus;
+		bool prevJumping = game.playerShip && game.playerShip->jumping;
 
-		if (shipStatus.ship)
-		{
-			if (!game.playerShip) game.playerShip.emplace();
-
-			bool prevJumping = game.playerShip->jumping;
-
-			readPlayerShip(
-				*game.playerShip,
-				game.playerCrew,
-				game.enemyCrew,
-				*rs.app->gui,
-				rs.powerManagerContainer->powerManagers[0],
-				playerShipPos, enemyShipPos
-			);
-
-			game.justJumped = prevJumping && !game.playerShip->jumping;
-		}
-		else
-		{
-			game.playerShip.reset();
-			game.justJumped = false;
-		}
+		if (!shipStatus.ship) game.playerShip.reset();
+		else if (!game.playerShip) game.playerShip.emplace();
 
-		// For accessing the enemy's CompleteShip instance
-		auto& completePlayerShip = rs.app->world->playerShip;
+		if (!enemyCompleteShip) game.enemyShip.reset();
+		else if (!game.enemyShip) game.enemyShip.emplace();
 
-		if (completePlayerShip)
-		{
-			auto* enemy = completePlayerShip->enemyShip;
+		runTasks({
+			[&] {
+				if (!game.playerShip) return;
 
-			if (enemy)
-			{
-				if (!game.enemyShip) game.enemyShip.emplace();
+				readPlayerShip(
+					*game.playerShip,
+					game.playerCrew,
+					game.enemyCrew,
+					*rs.app->gui,
+					rs.powerManagerContainer->powerManagers[0],
+					playerShipPos, enemyShipPos
+				);
+			},
+			[&] {
+				if (!game.enemyShip) return;
 
 				readEnemyShip(
 					*game.enemyShip,
 					game.enemyCrew,
 					game.playerCrew,
-					*enemy,
+					*enemyCompleteShip,
 					rs.powerManagerContainer->powerManagers[1],
 					playerShipPos, enemyShipPos
 				);
 			}
-			else
-			{
-				game.enemyShip.reset();
-			}
+		});
+
+		game.justJumped = game.playerShip && prevJumping && !game.playerShip->jumping;
+
+		// Events from the previous sector or run may be freed and their addresses reused
+		// Restarting from the game over screen can land on the same sector at the same address,
+		// so a new run always clears the cache too
+		auto&& rawStarMap = rs.app->world->starMap;
+
+		if (newRun)
+		{
+			// The map and the current event hold onto old events too, so they get read from scratch
+			game._events.clear();
+			game.starMap._sectorPtr = nullptr;
+			game.event.reset();
 		}
+		else if (sectorChanged(game.starMap, rawStarMap)) game._events.clear();
+		else refreshEventCache(game._events, rs.app->world->baseLocationEvent, rawStarMap);
 
 		// Read the event stuff
-		if (game.pause.event || game.pause.menu || game.justJumped || game.justLoaded)
+		if (game.pause.event || game.pause.menu || game.justJumped || newRun)
 		{
 			auto&& choices = rs.app->world->choiceHistory;
 			auto* current = rs.app->world->baseLocationEvent;
@@ -2941,12 +3400,12 @@ void Reader::read()
 				// Only null store pointer when jumping
 				bool preserveStore = game.event && game.playerShip && !game.playerShip->jumping;
 				if (!preserveStore) game.event.emplace();
-				readLocationEvent(*game.event, *current, preserveStore);
+				readLocationEvent(*game.event, *current, game._events, preserveStore);
 			}
 			else game.event.reset();
 		}
 
-		readStarMap(game.starMap, rs.app->world->starMap);
+		readStarMap(game.starMap, rawStarMap, game._events);
 
 		if (game.justLoaded) game.justLoaded = false;
 	}
@@ -2965,9 +3424,29 @@ void Reader::read()
 	}
 }
 
+void Reader::runTasks(std::initializer_list<TaskPool::Task> tasks)
+{
+	if (pool)
+	{
+		pool->run(tasks);
+		return;
+	}
+
+	for (auto&& task : tasks)
+	{
+		task();
+	}
+}
+
 void Reader::iterate()
 {
+	auto allocationsBefore = allocationCount();
+	auto before = Clock::now();
 	Reader::read();
+	if (encoder) encoder->encode(state);
+	lastRead = Clock::now() - before;
+	lastReadAllocations = allocationCount() - allocationsBefore;
+
 	if (Input::ready()) Input::iterate();
 }
 
@@ -2999,6 +3478,45 @@ double Reader::now()
 	return toDouble(Clock::now() - start);
 }
 
+void Reader::setParallelRead(bool on)
+{
+	if (!on)
+	{
+		pool.reset();
+	}
+	else if (!pool)
+	{
+		// At most 3 things get read at once, and the reading thread is one of them
+		size_t threads = std::clamp(std::thread::hardware_concurrency(), 2u, 3u) - 1;
+		pool = std::make_unique<TaskPool>(threads);
+	}
+}
+
+bool Reader::parallelRead()
+{
+	return pool != nullptr;
+}
+
+void Reader::setObservationEncoder(std::shared_ptr<ObservationEncoder> encoder)
+{
+	Reader::encoder = std::move(encoder);
+}
+
+std::shared_ptr<ObservationEncoder> Reader::observationEncoder()
+{
+	return encoder;
+}
+
+double Reader::readTime()
+{
+	return toDouble(lastRead);
+}
+
+uintmax_t Reader::readAllocations()
+{
+	return lastReadAllocations;
+}
+
 const State& Reader::getState()
 {
 	return state;
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "Utility/ValueScopeGuard.hpp"
+#include "Utility/TaskPool.hpp"
 #include "State.hpp"
+#include "Observation.hpp"
 #include "Raw.hpp"
 
 #include <chrono>
+#include <memory>
 
 class MutableRawState
 {
@@ -30,6 +33,16 @@ public:
 	static bool init(); // returns true if successful, false otherwise
 
 	static double now(); // gets the time since start in seconds
+	static double readTime(); // gets how long the last read took in seconds
+	static uintmax_t readAllocations(); // gets how many heap allocations the last read made
+
+	// Reads independent parts of the state (space, crew, ships) on worker threads
+	static void setParallelRead(bool on = true);
+	static bool parallelRead();
+
+	// Encodes the state with this after every read, nullptr to stop
+	static void setObservationEncoder(std::shared_ptr<ObservationEncoder> encoder);
+	static std::shared_ptr<ObservationEncoder> observationEncoder();
 
 	static const State& getState();
 	static const raw::State& getRawState();
@@ -51,7 +64,14 @@ private:
 	static void iterate(); // handles polling, and input (if ready)
 	static void read(); // process polling
 
+	// runs the tasks on the pool if reading in parallel, otherwise one by one
+	static void runTasks(std::initializer_list<TaskPool::Task> tasks);
+
 	static TimePoint start;
+	static Duration lastRead;
+	static uintmax_t lastReadAllocations;
+	static std::unique_ptr<TaskPool> pool;
+	static std::shared_ptr<ObservationEncoder> encoder;
 
 	static raw::State rs;
 	static State state;
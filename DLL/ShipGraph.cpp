@@ -0,0 +1,360 @@
+#include "ShipGraph.hpp"
+
+#include <mutex>
+#include <queue>
+#include <cmath>
+#include <string>
+#include <stdexcept>
+#include <algorithm>
+#include <functional>
+
+namespace
+{
+
+constexpr float TILE = float(Room::HARDCODED_TILE_SIZE);
+const float DIAGONAL = TILE * std::sqrt(2.f);
+
+bool validRoom(const std::vector<Room>& rooms, int room)
+{
+	return room >= 0 && size_t(room) < rooms.size();
+}
+
+// Finds the slots a door joins, by looking half a tile to either side of its middle
+// Gives false for airlocks, or if the door isn't against both of its rooms
+bool doorSlots(const Door& door, const std::vector<Room>& rooms, int& slotA, int& slotB)
+{
+	auto [roomA, roomB] = door.rooms;
+
+	if (!validRoom(rooms, roomA) || !validRoom(rooms, roomB)) return false;
+
+	Point<int> middle{ door.rect.x + door.rect.w / 2, door.rect.y + door.rect.h / 2 };
+	Point<int> step = door.vertical
+		? Point<int>{ Room::HARDCODED_TILE_SIZE / 2, 0 }
+		: Point<int>{ 0, Room::HARDCODED_TILE_SIZE / 2 };
+
+	auto slotIn = [&](const Room& room) {
+		for (auto&& side : { middle - step, middle + step })
+		{
+			if (room.rect.contains(side)) return room.slotIdAt(side);
+		}
+
+		return -1;
+	};
+
+	slotA = slotIn(rooms[roomA]);
+	slotB = slotIn(rooms[roomB]);
+
+	return
+		slotA >= 0 && size_t(slotA) < rooms[roomA].slots.size() &&
+		slotB >= 0 && size_t(slotB) < rooms[roomB].slots.size();
+}
+
+}
+
+ShipLayout ShipGraph::layoutOf(const std::vector<Room>& rooms, const std::vector<Door>& doors)
+{
+	ShipLayout layout;
+	layout.rooms.reserve(rooms.size());
+
+	std::vector<int> offsets{ 0 };
+	offsets.reserve(rooms.size() + 1);
+
+	for (auto&& room : rooms)
+	{
+		layout.rooms.emplace_back(room.tiles.x, room.tiles.y);
+		offsets.push_back(offsets.back() + room.tiles.x * room.tiles.y);
+	}
+
+	for (auto&& door : doors)
+	{
+		int slotA, slotB;
+		if (!doorSlots(door, rooms, slotA, slotB)) continue;
+
+		layout.connections.push_back({
+			door.id,
+			offsets[door.rooms.first] + slotA,
+			offsets[door.rooms.second] + slotB
+		});
+	}
+
+	return layout;
+}
+
+std::shared_ptr<const ShipGraph> ShipGraph::cached(const ShipLayout& layout)
+{
+	// Both ships are read at the same time, so this has to be locked
+	// There's only ever a handful of layouts in a run, so they're just searched in order
+	static std::mutex mutex;
+	static std::vector<std::shared_ptr<const ShipGraph>> graphs;
+
+	std::lock_guard lock(mutex);
+
+	for (auto&& graph : graphs)
+	{
+		if (graph->layout() == layout) return graph;
+	}
+
+	return graphs.emplace_back(std::make_shared<const ShipGraph>(layout));
+}
+
+ShipGraph::ShipGraph(ShipLayout layout)
+	: shape(std::move(layout))
+{
+	this->roomOffsets.reserve(this->shape.rooms.size() + 1);
+	this->roomOffsets.push_back(0);
+
+	for (auto&& [w, h] : this->shape.rooms)
+	{
+		this->roomOffsets.push_back(this->roomOffsets.back() + w * h);
+	}
+
+	int nodes = this->nodeCount();
+	std::vector<std::vector<Edge>> adjacency(nodes);
+
+	// Inside a room, every tile leads to the 8 around it
+	for (size_t room = 0; room < this->shape.rooms.size(); room++)
+	{
+		auto [w, h] = this->shape.rooms[room];
+		int first = this->roomOffsets[room];
+
+		for (int y = 0; y < h; y++)
+		{
+			for (int x = 0; x < w; x++)
+			{
+				for (int dy = -1; dy <= 1; dy++)
+				{
+					for (int dx = -1; dx <= 1; dx++)
+					{
+						int nx = x + dx, ny = y + dy;
+						if ((dx == 0 && dy == 0) || nx < 0 || ny < 0 || nx >= w || ny >= h) continue;
+
+						float weight = dx != 0 && dy != 0 ? DIAGONAL : TILE;
+						adjacency[first + x + w * y].push_back({ first + nx + w * ny, weight, -1 });
+					}
+				}
+			}
+		}
+	}
+
+	int doorCount = 0;
+
+	for (auto&& connection : this->shape.connections)
+	{
+		adjacency[connection.from].push_back({ connection.to, TILE, connection.door });
+		adjacency[connection.to].push_back({ connection.from, TILE, connection.door });
+		doorCount = std::max(doorCount, connection.door + 1);
+	}
+
+	// Flattened so walking the edges doesn't hop around memory
+	this->edgeOffsets.reserve(nodes + 1);
+	this->edgeOffsets.push_back(0);
+
+	for (auto&& list : adjacency)
+	{
+		this->edges.insert(this->edges.end(), list.begin(), list.end());
+		this->edgeOffsets.push_back(int(this->edges.size()));
+	}
+
+	this->blocked.assign(doorCount, false);
+	this->computeDistances();
+}
+
+bool ShipGraph::matches(const std::vector<Room>& rooms, const std::vector<Door>& doors) const
+{
+	if (rooms.size() != this->shape.rooms.size()) return false;
+
+	for (size_t i = 0; i < rooms.size(); i++)
+	{
+		auto [w, h] = this->shape.rooms[i];
+		if (rooms[i].tiles.x != w || rooms[i].tiles.y != h) return false;
+	}
+
+	size_t next = 0;
+
+	for (auto&& door : doors)
+	{
+		int slotA, slotB;
+		if (!doorSlots(door, rooms, slotA, slotB)) continue;
+		if (next >= this->shape.connections.size()) return false;
+
+		auto&& connection = this->shape.connections[next++];
+
+		if (connection.door != door.id ||
+			connection.from != this->roomOffsets[door.rooms.first] + slotA ||
+			connection.to != this->roomOffsets[door.rooms.second] + slotB)
+		{
+			return false;
+		}
+	}
+
+	return next == this->shape.connections.size();
+}
+
+int ShipGraph::node(int room, int slot) const
+{
+	if (room < 0 || size_t(room) >= this->shape.rooms.size()) return -1;
+
+	int first = this->roomOffsets[room];
+	int count = this->roomOffsets[room + 1] - first;
+
+	if (slot < 0 || slot >= count) return -1;
+
+	return first + slot;
+}
+
+std::pair<int, int> ShipGraph::slotOf(int node) const
+{
+	if (node < 0 || node >= this->nodeCount())
+	{
+		throw std::out_of_range("there is no node " + std::to_string(node));
+	}
+
+	auto it = std::upper_bound(this->roomOffsets.begin(), this->roomOffsets.end(), node);
+	int room = int(it - this->roomOffsets.begin()) - 1;
+
+	return { room, node - this->roomOffsets[room] };
+}
+
+float ShipGraph::distance(int roomA, int slotA, int roomB, int slotB) const
+{
+	int a = this->node(roomA, slotA);
+	int b = this->node(roomB, slotB);
+
+	if (a < 0 || b < 0)
+	{
+		int room = a < 0 ? roomA : roomB;
+		int slot = a < 0 ? slotA : slotB;
+
+		throw std::out_of_range(
+			"there is no slot " + std::to_string(slot) + " in room " + std::to_string(room)
+		);
+	}
+
+	return this->at(a, b);
+}
+
+float ShipGraph::nodeDistance(int a, int b) const
+{
+	if (a < 0 || b < 0 || a >= this->nodeCount() || b >= this->nodeCount())
+	{
+		throw std::out_of_range("there is no node " + std::to_string(a < 0 || a >= this->nodeCount() ? a : b));
+	}
+
+	return this->at(a, b);
+}
+
+void ShipGraph::setDoorBlocked(int door, bool blocked)
+{
+	// Airlocks have the last ids and don't join two rooms, so they aren't in the graph anyway
+	if (door < 0 || size_t(door) >= this->blocked.size()) return;
+	if (this->blocked[door] == blocked) return;
+	this->blocked[door] = blocked;
+
+	if (blocked)
+	{
+		this->computeDistances();
+		return;
+	}
+
+	for (auto&& connection : this->shape.connections)
+	{
+		if (connection.door == door) this->relaxThrough(connection);
+	}
+}
+
+bool ShipGraph::doorBlocked(int door) const
+{
+	return door >= 0 && size_t(door) < this->blocked.size() && this->blocked[door];
+}
+
+std::vector<int> ShipGraph::blockedDoors() const
+{
+	std::vector<int> doors;
+
+	for (size_t i = 0; i < this->blocked.size(); i++)
+	{
+		if (this->blocked[i]) doors.push_back(int(i));
+	}
+
+	return doors;
+}
+
+void ShipGraph::unblockDoors()
+{
+	if (std::find(this->blocked.begin(), this->blocked.end(), true) == this->blocked.end()) return;
+
+	std::fill(this->blocked.begin(), this->blocked.end(), false);
+	this->computeDistances();
+}
+
+// Dijkstra from every node
+// Ships only have a few dozen tiles, so this is quick enough to do whenever a door gets blocked
+void ShipGraph::computeDistances()
+{
+	using Entry = std::pair<float, int>;
+
+	int nodes = this->nodeCount();
+	this->distances.assign(size_t(nodes) * nodes, UNREACHABLE);
+
+	// Always empty by the end of each search, so it's reused to keep its memory
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+	for (int source = 0; source < nodes; source++)
+	{
+		this->at(source, source) = 0.f;
+		open.emplace(0.f, source);
+
+		while (!open.empty())
+		{
+			auto [dist, current] = open.top();
+			open.pop();
+
+			if (dist > this->at(source, current)) continue;
+
+			for (int i = this->edgeOffsets[current]; i < this->edgeOffsets[current + 1]; i++)
+			{
+				auto&& edge = this->edges[i];
+				if (this->doorBlocked(edge.door)) continue;
+
+				float next = dist + edge.weight;
+
+				if (next < this->at(source, edge.to))
+				{
+					this->at(source, edge.to) = next;
+					open.emplace(next, edge.to);
+				}
+			}
+		}
+	}
+}
+
+// Opening a door can only make paths through it shorter,
+// so every pair just has to check if going through the door beats what it had
+void ShipGraph::relaxThrough(const ShipLayout::Connection& connection)
+{
+	int nodes = this->nodeCount();
+	int u = connection.from, v = connection.to;
+
+	// Copied, since the rows and columns through u and v change as this goes
+	std::vector<float> toU(nodes), toV(nodes), fromU(nodes), fromV(nodes);
+
+	for (int i = 0; i < nodes; i++)
+	{
+		toU[i] = this->at(i, u);
+		toV[i] = this->at(i, v);
+		fromU[i] = this->at(u, i);
+		fromV[i] = this->at(v, i);
+	}
+
+	for (int i = 0; i < nodes; i++)
+	{
+		for (int j = 0; j < nodes; j++)
+		{
+			float through = std::min(
+				toU[i] + TILE + fromV[j],
+				toV[i] + TILE + fromU[j]);
+
+			if (through < this->at(i, j)) this->at(i, j) = through;
+		}
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "State/Room.hpp"
+#include "State/Door.hpp"
+
+#include <vector>
+#include <memory>
+#include <utility>
+#include <limits>
+
+// What a ship's layout boils down to for walking around it:
+// how many tiles each room has, and which tiles each door joins together
+struct ShipLayout
+{
+	struct Connection
+	{
+		int door = -1;
+		int from = -1, to = -1; // nodes on either side of the door
+
+		bool operator==(const Connection&) const = default;
+	};
+
+	std::vector<std::pair<int, int>> rooms; // tiles in each direction, indexed by room id
+	std::vector<Connection> connections;
+
+	bool operator==(const ShipLayout&) const = default;
+};
+
+// Every slot in a ship and the shortest walking distance between any two of them
+// Distances are all worked out up front, so looking one up doesn't search anything
+// Crew walk diagonally inside rooms and from tile to tile through doors
+// Distances are in pixels at 1280x720, same as Room::HARDCODED_TILE_SIZE
+class ShipGraph
+{
+public:
+	static constexpr float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+	// Works out the layout of a ship, airlocks don't connect anything
+	static ShipLayout layoutOf(const std::vector<Room>& rooms, const std::vector<Door>& doors);
+
+	// Gets the graph of a layout, only building it the first time the layout is seen
+	// The cached graph has no doors blocked, so copy it before blocking any
+	static std::shared_ptr<const ShipGraph> cached(const ShipLayout& layout);
+
+	explicit ShipGraph(ShipLayout layout);
+
+	// Checks if the rooms and doors still have this graph's layout, without allocating
+	bool matches(const std::vector<Room>& rooms, const std::vector<Door>& doors) const;
+
+	const ShipLayout& layout() const { return this->shape; }
+	int nodeCount() const { return this->roomOffsets.back(); }
+
+	// Gets the node of a slot, or -1 if there's no such slot
+	int node(int room, int slot) const;
+
+	// Gets the room and slot of a node
+	std::pair<int, int> slotOf(int node) const;
+
+	// Throws std::out_of_range if a room or slot doesn't exist
+	// Gives UNREACHABLE if blocked doors cut the slots off from each other
+	float distance(int roomA, int slotA, int roomB, int slotB) const;
+	float nodeDistance(int a, int b) const;
+
+	// Blocking is for doors crew can't walk through, e.g. locked doors on the enemy ship
+	// Unblocking only relaxes the distances through that door, blocking recomputes all of them
+	// Does nothing for doors that aren't in the graph, like airlocks
+	void setDoorBlocked(int door, bool blocked = true);
+	bool doorBlocked(int door) const;
+	std::vector<int> blockedDoors() const;
+	void unblockDoors();
+
+private:
+	struct Edge
+	{
+		int to = -1;
+		float weight = 0.f;
+		int door = -1; // -1 for walking inside a room
+	};
+
+	void computeDistances();
+	void relaxThrough(const ShipLayout::Connection& connection);
+
+	float& at(int a, int b) { return this->distances[size_t(a) * this->nodeCount() + b]; }
+	float at(int a, int b) const { return this->distances[size_t(a) * this->nodeCount() + b]; }
+
+	ShipLayout shape;
+	std::vector<int> roomOffsets; // first node of each room, with the node count at the end
+	std::vector<int> edgeOffsets; // edges of node i are edges[edgeOffsets[i]] to edges[edgeOffsets[i+1]]
+	std::vector<Edge> edges;
+	std::vector<float> distances; // nodeCount() by nodeCount()
+	std::vector<bool> blocked; // indexed by door id
+};
@@ -31,6 +31,9 @@ struct Game
 	std::optional<LocationEvent> event;
 	std::optional<Ship> playerShip, enemyShip;
 	std::vector<Crew> playerCrew, enemyCrew;
+
+	// Some implementation stuffs
+	EventCache _events; // cleared every sector
 };
 
 struct State
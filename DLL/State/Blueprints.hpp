@@ -5,9 +5,20 @@
 #include "Augment.hpp"
 #include "CrewBlueprint.hpp"
 #include "SystemBlueprint.hpp"
+#include "SystemType.hpp"
 
 #include <string>
 #include <map>
+#include <array>
+#include <variant>
+#include <unordered_map>
+
+namespace raw
+{
+
+struct Blueprint;
+
+}
 
 struct Blueprints
 {
@@ -24,4 +35,21 @@ struct Blueprints
 	std::map<std::string, SystemBlueprint> systemBlueprints;
 	//gcc::map<gcc::string, gcc::vector<gcc::string>> blueprintLists;
 	//gcc::vector<gcc::string> currentNames;
+
+	// Some implementation stuffs
+	// These are filled in once when the blueprints are read,
+	// so the rest of the state can point to blueprints without looking them up by name
+	std::unordered_map<const raw::Blueprint*, const Blueprint*> _byRaw;
+	std::array<const SystemBlueprint*, size_t(SystemType::Hacking) + 1> _systems{};
+
+	// Blueprints the game made outside of its tables, read the first time they're looked up in each read
+	// Mutable since that happens while reading the rest of the state
+	struct RuntimeBlueprint
+	{
+		std::variant<WeaponBlueprint, DroneBlueprint, Augment, SystemBlueprint> blueprint;
+		unsigned generation = 0; // the read it was last read in
+	};
+
+	mutable std::unordered_map<const raw::Blueprint*, RuntimeBlueprint> _runtime;
+	unsigned _generation = 0; // goes up every read
 };
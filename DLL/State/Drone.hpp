@@ -30,7 +30,7 @@ struct SpaceDroneInfo
 	float angle = 0.f, angleDesired = 0.f, angleMalfunction = 0.f;
 	float ionTime = 0.f;
 
-	std::optional<WeaponBlueprint> weapon;
+	const WeaponBlueprint* weapon = nullptr;
 	std::optional<SpaceDroneMovementExtra> extraMovement;
 };
 
@@ -40,7 +40,7 @@ struct Drone
 	static constexpr float HARDCODED_SAFE_MALFUNCTION_TIME = 2.f;
 
 	int slot = -1;
-	DroneBlueprint blueprint;
+	const DroneBlueprint* blueprint = nullptr;
 	Power power;
 	bool player = false;
 	bool dead = false;
@@ -64,26 +64,26 @@ struct Drone
 	bool crewDrone() const
 	{
 		return
-			this->blueprint.type == DroneType::AntiBoarder ||
-			this->blueprint.type == DroneType::SystemRepair;
+			this->blueprint->type == DroneType::AntiBoarder ||
+			this->blueprint->type == DroneType::SystemRepair;
 	}
 
 	bool spaceDrone() const
 	{
 		return
-			this->blueprint.type == DroneType::Combat ||
-			this->blueprint.type == DroneType::Defense ||
-			this->blueprint.type == DroneType::HullRepair ||
-			this->blueprint.type == DroneType::Hacking ||
-			this->blueprint.type == DroneType::Shield;
+			this->blueprint->type == DroneType::Combat ||
+			this->blueprint->type == DroneType::Defense ||
+			this->blueprint->type == DroneType::HullRepair ||
+			this->blueprint->type == DroneType::Hacking ||
+			this->blueprint->type == DroneType::Shield;
 	}
 
 	bool needsEnemy() const
 	{
 		return
-			this->blueprint.type == DroneType::Combat ||
-			this->blueprint.type == DroneType::Boarder ||
-			this->blueprint.type == DroneType::Hacking;
+			this->blueprint->type == DroneType::Combat ||
+			this->blueprint->type == DroneType::Boarder ||
+			this->blueprint->type == DroneType::Hacking;
 	}
 };
 
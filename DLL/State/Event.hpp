@@ -12,6 +12,7 @@
 #include <optional>
 #include <memory>
 #include <variant>
+#include <unordered_map>
 
 struct ShipEvent
 {
@@ -54,13 +55,14 @@ enum class StoreBoxType
 
 struct StoreBox
 {
+	// Crew are unique to the store, so they're not shared with the blueprint tables
 	using Item = std::variant<
 		std::monostate,
-		WeaponBlueprint,
-		DroneBlueprint,
-		Augment,
+		const WeaponBlueprint*,
+		const DroneBlueprint*,
+		const Augment*,
 		CrewBlueprint,
-		SystemBlueprint
+		const SystemBlueprint*
 	>;
 
 	StoreBoxType type = StoreBoxType::Invalid;
@@ -106,6 +108,7 @@ namespace raw
 {
 
 struct Store;
+struct LocationEvent;
 
 }
 
@@ -129,4 +132,10 @@ struct LocationEvent
 
 	// Some implementation stuffs
 	raw::Store* _storePtr = nullptr;
+	const raw::LocationEvent* _rawPtr = nullptr;
 };
+
+// Events that were already read, keyed by the raw event they were read from
+// The game doesn't modify events once they're generated (apart from stores),
+// so these are shared between every choice that leads to them
+using EventCache = std::unordered_map<const raw::LocationEvent*, std::shared_ptr<LocationEvent>>;
@@ -2,9 +2,13 @@
 
 #include "Point.hpp"
 #include "Key.hpp"
+#include "SystemType.hpp"
 
 #include <string>
 #include <map>
+#include <array>
+#include <optional>
+#include <vector>
 
 enum class FullscreenMode : int
 {
@@ -21,6 +25,73 @@ enum class EventChoiceSelection : int
 	DisableHotkeys, NoDelay, BriefDelay
 };
 
+// Hotkeys with fixed names that commands use
+enum class Hotkey : int
+{
+	ActivateBattery,
+	ActivateCloak,
+	Autofire,
+	CloseDoors,
+	CrewAll,
+	ForceAutofire,
+	Jump,
+	LoadStations,
+	Lockdown,
+	MindControl,
+	OpenDoors,
+	ReturnTeleport,
+	SaveStations,
+	SendTeleport,
+	ShipCargo,
+	ShipCrew,
+	ShipInfo,
+	StartHacking,
+	Store,
+	Count
+};
+
+inline const std::string& hotkeyName(Hotkey hotkey)
+{
+	static const std::array<std::string, size_t(Hotkey::Count)> names{
+		"activate_battery",
+		"activate_cloak",
+		"autofire",
+		"close",
+		"crew_all",
+		"force_autofire",
+		"jump",
+		"loadPositions",
+		"lockdown",
+		"mindControl",
+		"open",
+		"ret_tele",
+		"savePositions",
+		"send_tele",
+		"ship_inv",
+		"ship_crew",
+		"ship_info",
+		"start_hacking",
+		"store",
+	};
+
+	return names[size_t(hotkey)];
+}
+
+// The hotkey dictionary resolved into arrays, so commands don't need to look up strings
+// An empty entry means the game has no hotkey by that name
+struct HotkeyTable
+{
+	using Entry = std::optional<Key>;
+
+	static constexpr size_t SYSTEMS = size_t(SystemType::Hacking) + 1;
+
+	std::array<Entry, size_t(Hotkey::Count)> named;
+	std::array<Entry, SYSTEMS> systemPower, systemUnpower; // empty if the system has none
+	std::array<Entry, 8> power, unpower; // by ui box, "power_1" is at 0
+	std::array<Entry, 8> crew; // by crew id, "crew1" is at 0
+	std::array<Entry, 4> weapons, drones; // by slot, "weapon1" is at 0
+};
+
 struct Settings
 {
 	FullscreenMode fullscreen = FullscreenMode::Off;
@@ -41,4 +112,8 @@ struct Settings
 	Point<int> screenSize;
 	EventChoiceSelection eventChoiceSelection = EventChoiceSelection::DisableHotkeys;
 	std::map<std::string, Key> hotkeys;
+
+	// Some implementation stuffs
+	HotkeyTable _hotkeyTable;
+	std::vector<int> _rawHotkeys; // the raw keys the table was made from
 };
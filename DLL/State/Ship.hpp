@@ -7,11 +7,21 @@
 #include "Systems.hpp"
 
 #include <vector>
+#include <memory>
 #include <utility>
 #include <optional>
 #include <variant>
 #include <stdexcept>
 
+class ShipGraph;
+
+namespace raw
+{
+
+struct ShipManager;
+
+}
+
 using CargoItem =
 	std::variant<
 		std::monostate,
@@ -75,6 +85,7 @@ struct Ship
 
 	std::vector<Room> rooms;
 	std::vector<Door> doors;
+	std::shared_ptr<ShipGraph> graph; // only rebuilt when the rooms/doors change
 
 	Reactor reactor;
 	std::optional<ShieldSystem> shields;
@@ -133,4 +144,7 @@ struct Ship
 		if (this->battery) ++res;
 		return res;
 	}
+
+	// Some implementation stuffs
+	const raw::ShipManager* _rawPtr = nullptr;
 };
@@ -9,6 +9,14 @@
 #include <vector>
 #include <string>
 
+namespace raw
+{
+
+struct Location;
+struct Sector;
+
+}
+
 enum class SectorType
 {
 	Invalid = -1,
@@ -27,6 +35,9 @@ struct Sector
 	Rect<int> hitbox;
 	int level = -1;
 	bool unique = false;
+
+	// Some implementation stuffs
+	const raw::Sector* _rawPtr = nullptr;
 };
 
 struct Location
@@ -45,6 +56,9 @@ struct Location
 	bool fleetOvertaking = false;
 	bool enemyShip = false;
 	LocationEvent event;
+
+	// Some implementation stuffs
+	const raw::Location* _rawPtr = nullptr;
 };
 
 struct StarMap
@@ -66,4 +80,7 @@ struct StarMap
 	bool nebulaSector = false;
 	bool distressBeacon = false;
 	int sectorNumber = -1;
+
+	// Some implementation stuffs
+	const raw::Sector* _sectorPtr = nullptr;
 };
@@ -14,7 +14,7 @@ struct System
 {
 	int uiBox = -1, discriminator = 0;
 	SystemType type = SystemType::None;
-	SystemBlueprint blueprint;
+	const SystemBlueprint* blueprint = nullptr;
 	int room = -1;
 	Power power;
 	std::pair<int, int> health{ 0, 0 }, level{ 0, 0 };
@@ -11,7 +11,7 @@ struct Weapon
 
 	int slot = -1;
 	std::pair<float, float> cooldown{ 0.f, 0.f };
-	WeaponBlueprint blueprint;
+	const WeaponBlueprint* blueprint = nullptr;
 	Power power;
 	bool player = false;
 	bool autofire = false;
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstdint>
+
+// Counts every allocation made through operator new by this DLL
+// Allocations the game makes itself aren't counted
+uintmax_t allocationCount();
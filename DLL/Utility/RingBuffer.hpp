@@ -0,0 +1,143 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+// A double-ended queue stored in one contiguous block that wraps around
+// It only allocates when it has to grow, so pushing/popping is allocation-free once warmed up
+// Popped elements aren't destroyed, they stay in their slot until overwritten
+// That way things like strings in them keep their capacity for the next push
+template<typename T>
+class RingBuffer
+{
+public:
+	explicit RingBuffer(size_t capacity = 64)
+	{
+		size_t cap = 1;
+		while (cap < capacity) cap <<= 1;
+		this->slots.resize(cap);
+	}
+
+	bool empty() const
+	{
+		return this->count == 0;
+	}
+
+	size_t size() const
+	{
+		return this->count;
+	}
+
+	size_t capacity() const
+	{
+		return this->slots.size();
+	}
+
+	T& front()
+	{
+		return (*this)[0];
+	}
+
+	const T& front() const
+	{
+		return (*this)[0];
+	}
+
+	T& back()
+	{
+		return (*this)[this->count - 1];
+	}
+
+	const T& back() const
+	{
+		return (*this)[this->count - 1];
+	}
+
+	// Index 0 is the front
+	T& operator[](size_t i)
+	{
+		return this->slots[this->wrap(this->head + i)];
+	}
+
+	const T& operator[](size_t i) const
+	{
+		return this->slots[this->wrap(this->head + i)];
+	}
+
+	template<typename U>
+	T& push_back(U&& value)
+	{
+		this->reserveOneMore();
+		auto&& slot = this->slots[this->wrap(this->head + this->count)];
+		slot = std::forward<U>(value);
+		this->count++;
+		return slot;
+	}
+
+	template<typename U>
+	T& push_front(U&& value)
+	{
+		this->reserveOneMore();
+		this->head = this->wrap(this->head + this->capacity() - 1);
+		auto&& slot = this->slots[this->head];
+		slot = std::forward<U>(value);
+		this->count++;
+		return slot;
+	}
+
+	void pop_front()
+	{
+		this->head = this->wrap(this->head + 1);
+		this->count--;
+	}
+
+	// Removes every element the predicate returns true for, keeping the order of the rest
+	template<typename F>
+	size_t eraseIf(F&& pred)
+	{
+		size_t kept = 0;
+
+		for (size_t i = 0; i < this->count; i++)
+		{
+			if (pred(std::as_const((*this)[i]))) continue;
+			if (kept != i) std::swap((*this)[kept], (*this)[i]);
+			kept++;
+		}
+
+		size_t erased = this->count - kept;
+		this->count = kept;
+		return erased;
+	}
+
+	void clear()
+	{
+		this->head = 0;
+		this->count = 0;
+	}
+
+private:
+	size_t wrap(size_t i) const
+	{
+		return i & (this->capacity() - 1);
+	}
+
+	// Doubles the capacity if full, moving everything so the front is at index 0
+	void reserveOneMore()
+	{
+		if (this->count < this->capacity()) return;
+
+		std::vector<T> grown(this->capacity() * 2);
+
+		for (size_t i = 0; i < this->count; i++)
+		{
+			grown[i] = std::move((*this)[i]);
+		}
+
+		this->slots = std::move(grown);
+		this->head = 0;
+	}
+
+	std::vector<T> slots;
+	size_t head = 0, count = 0;
+};
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <deque>
+#include <vector>
+#include <initializer_list>
+
+// A small pool of persistent worker threads for running a batch of tasks at once
+class TaskPool
+{
+public:
+	using Task = std::function<void()>;
+
+	explicit TaskPool(size_t threads)
+	{
+		for (size_t i = 0; i < threads; i++)
+		{
+			this->workers.emplace_back([this](std::stop_token stop) { this->work(stop); });
+		}
+	}
+
+	~TaskPool()
+	{
+		{
+			std::lock_guard lock(this->mutex);
+
+			for (auto&& worker : this->workers)
+			{
+				worker.request_stop();
+			}
+		}
+
+		this->cv.notify_all();
+	}
+
+	TaskPool(const TaskPool&) = delete;
+	TaskPool& operator=(const TaskPool&) = delete;
+
+	// Runs the tasks and returns once they're all finished
+	// The calling thread runs tasks too instead of just waiting
+	// If any of the tasks threw, the first exception is rethrown here
+	void run(std::initializer_list<Task> tasks)
+	{
+		Batch batch;
+		batch.remaining = tasks.size();
+
+		{
+			std::lock_guard lock(this->mutex);
+
+			for (auto&& task : tasks)
+			{
+				this->queue.push_back({ &task, &batch });
+			}
+		}
+
+		this->cv.notify_all();
+
+		// Help out until our batch is empty
+		while (this->runOne());
+
+		std::unique_lock lock(this->mutex);
+		batch.done.wait(lock, [&] { return batch.remaining == 0; });
+
+		if (batch.error) std::rethrow_exception(batch.error);
+	}
+
+	size_t size() const
+	{
+		return this->workers.size();
+	}
+
+private:
+	struct Batch
+	{
+		size_t remaining = 0;
+		std::exception_ptr error;
+		std::condition_variable done;
+	};
+
+	struct Job
+	{
+		const Task* task = nullptr;
+		Batch* batch = nullptr;
+	};
+
+	// Runs one queued job, returns false if there weren't any
+	bool runOne()
+	{
+		Job job;
+
+		{
+			std::lock_guard lock(this->mutex);
+			if (this->queue.empty()) return false;
+			job = this->queue.front();
+			this->queue.pop_front();
+		}
+
+		this->execute(job);
+		return true;
+	}
+
+	void execute(const Job& job)
+	{
+		std::exception_ptr error;
+
+		try
+		{
+			(*job.task)();
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+
+		std::lock_guard lock(this->mutex);
+
+		if (error && !job.batch->error) job.batch->error = error;
+		if (--job.batch->remaining == 0) job.batch->done.notify_all();
+	}
+
+	void work(std::stop_token stop)
+	{
+		while (!stop.stop_requested())
+		{
+			Job job;
+
+			{
+				std::unique_lock lock(this->mutex);
+
+				this->cv.wait(lock, [&] {
+					return stop.stop_requested() || !this->queue.empty();
+				});
+
+				if (this->queue.empty()) continue;
+
+				job = this->queue.front();
+				this->queue.pop_front();
+			}
+
+			this->execute(job);
+		}
+	}
+
+	std::mutex mutex;
+	std::condition_variable cv;
+	std::deque<Job> queue;
+	std::vector<std::jthread> workers;
+};
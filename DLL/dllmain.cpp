@@ -159,8 +159,24 @@ BOOL __stdcall wglSwapBuffers_hook(HDC hDc)
 {
     if (g_quit) return true;
 
+    auto original = reinterpret_cast<wglSwapBuffers_t>(g_glHook.original());
+
     {
-        std::lock_guard lock(g_readerMutex);
+        std::unique_lock lock(g_readerMutex, std::try_to_lock);
+
+        // The Python thread holds the lock for as long as it's using the state,
+        // so instead of making the game wait for it, skip reading this frame.
+        // The state stays as it was until the Python thread is done with it,
+        // and the GUI from the last frame is drawn again so it doesn't flicker.
+        if (!lock.owns_lock())
+        {
+            if (g_imguiInit && ImGui::GetCurrentContext() && ImGui::GetDrawData())
+            {
+                ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+            }
+
+            return original(hDc);
+        }
 
         if (!g_imguiInit)
         {
@@ -213,7 +229,7 @@ BOOL __stdcall wglSwapBuffers_hook(HDC hDc)
 
     g_readerCV.notify_all();
 
-    return reinterpret_cast<wglSwapBuffers_t>(g_glHook.original())(hDc);
+    return original(hDc);
 }
 
 bool hookRenderer()
@@ -318,6 +334,8 @@ void mainLoop(py::module& pyMain)
         {
             pyMain.attr("on_update")();
         }
+
+        python_bindings::runEventLoop();
     }
     catch (const std::exception& e)
     {
@@ -382,6 +400,7 @@ void patcherThread(std::stop_token stop)
     }
 
     if (g_glHook.hooked()) unhookRenderer();
+    Reader::setParallelRead(false); // stop the reader's worker threads before the DLL unloads
     g_quit = true;
 }
 